@@ -0,0 +1,120 @@
+// Czas klatki ChartWindow dla obu sposobów rysowania (QT_QPA_PLATFORM=offscreen,
+// czyli renderowanie programowe, jak na stacjach bez GPU).
+// Każda klatka: blok próbek dla każdego strumienia, odświeżenie wykresów i obsługa
+// zaległych zdarzeń (w tym rysowania). Wynik: JSON z medianą, p99 i średnią [ms].
+
+#include "chartwindow.hpp"
+#include "telemetrystore.hpp"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+double percentileMs(std::vector<qint64> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    const std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index] / 1e6;
+}
+
+QJsonObject measure(ChartWindow::Renderer renderer, double rate, int frames, int streams)
+{
+    TelemetryStore store;
+    for (int id = 0; id < streams; ++id)
+        store.addSeries(id, QString("Stream %1").arg(id));
+    ChartWindow chart(nullptr, &store);
+    chart.setRenderer(renderer);
+    chart.resize(1200, 750);
+    chart.show();
+    QApplication::processEvents();
+
+    // Blok odpowiadający jednej klatce przy ~30 Hz odświeżania
+    const int blockSamples = std::max(1, static_cast<int>(rate / 30.0));
+    AccSampleBlock block(blockSamples);
+    qint64 n = 0;
+    std::vector<qint64> frameTimes;
+    frameTimes.reserve(static_cast<std::size_t>(frames));
+
+    // Pierwsza ćwiartka klatek to rozgrzewka, poza pomiarem
+    const qint64 start = accTimestampNow();
+    const qint64 periodNs = static_cast<qint64>(1e9 / rate);
+    for (int frame = -frames / 4; frame < frames; ++frame) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int id = 0; id < streams; ++id) {
+            // Wszystkie strumienie na tej samej osi czasu, przesuniętej o jedną klatkę na pętlę
+            qint64 timestamp = start + (frame + frames / 4) * static_cast<qint64>(blockSamples) * periodNs;
+            for (AccSample &sample : block) {
+                const double t = n++ * 0.01;
+                sample = {timestamp, std::sin(t), std::cos(t * 0.7), 0.5 * std::sin(t * 3.0)};
+                timestamp += periodNs;
+            }
+            store.append(id, block);
+        }
+        QMetaObject::invokeMethod(&chart, "refresh", Qt::DirectConnection);
+        QApplication::sendPostedEvents();
+        QApplication::processEvents();
+        if (frame >= 0)
+            frameTimes.push_back(timer.nsecsElapsed());
+    }
+
+    double sum = 0.0;
+    for (qint64 t : frameTimes)
+        sum += t / 1e6;
+    QJsonObject result;
+    result["renderer"] = renderer == ChartWindow::Renderer::Raster ? "raster" : "qtcharts";
+    result["p50Ms"] = percentileMs(frameTimes, 0.50);
+    result["p99Ms"] = percentileMs(frameTimes, 0.99);
+    result["meanMs"] = frameTimes.empty() ? 0.0 : sum / frameTimes.size();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Measured frames per renderer.", "count", "300");
+    QCommandLineOption rateOption("rate", "Sample rate per stream [Hz].", "hz", "1000");
+    QCommandLineOption streamsOption("streams", "Number of plots in the grid.", "count", "1");
+    parser.addOptions({framesOption, rateOption, streamsOption});
+    parser.process(app);
+
+    const int frames = std::max(1, parser.value(framesOption).toInt());
+    const double rate = parser.value(rateOption).toDouble();
+    const int streams = std::max(1, parser.value(streamsOption).toInt());
+
+    QJsonArray runs;
+    for (ChartWindow::Renderer renderer : {ChartWindow::Renderer::Charts, ChartWindow::Renderer::Raster}) {
+        const QJsonObject run = measure(renderer, rate, frames, streams);
+        std::fprintf(stderr, "%-9s p50 %.2f ms, p99 %.2f ms\n", qPrintable(run["renderer"].toString()),
+                     run["p50Ms"].toDouble(), run["p99Ms"].toDouble());
+        runs.append(run);
+    }
+
+    QJsonObject report;
+    report["benchmark"] = "charts";
+    report["platform"] = QString::fromLocal8Bit(qgetenv("QT_QPA_PLATFORM"));
+    report["rateHz"] = rate;
+    report["streams"] = streams;
+    report["frames"] = frames;
+    report["runs"] = runs;
+    const QByteArray json = QJsonDocument(report).toJson();
+    std::fwrite(json.constData(), 1, static_cast<std::size_t>(json.size()), stdout);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Benchmark detektora zdarzeń: koszt oceny reguł na próbkę dla wielu strumieni i reguł
+// oraz sprawdzenie, że wstrzyknięte zjawiska (spadek, uderzenie, drgania) są wykrywane.
+
+#include "eventdetector.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr double SampleRate = 4000.0;
+constexpr std::size_t BlockSize = 40;      ///< Próbek strumienia na takt 10 ms.
+constexpr std::size_t SamplesPerStream = 400000;
+
+// Lot spokojny z szumem; w środku 300 ms spadku, uderzenie i 2 s silnych drgań
+std::vector<AccSample> makeFlight(std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    const std::int64_t period = static_cast<std::int64_t>(1e9 / SampleRate);
+    std::vector<AccSample> samples(SamplesPerStream);
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        const double t = static_cast<double>(i) / SampleRate;
+        double z = 1.0;
+        double x = 0.1 * std::sin(2.0 * 3.14159265358979323846 * 180.0 * t);
+        if (t >= 20.0 && t < 20.3)
+            z = 0.05;
+        else if (t >= 20.3 && t < 20.302)
+            z = 5.0;
+        if (t >= 50.0 && t < 52.0)
+            x = 1.2 * std::sin(2.0 * 3.14159265358979323846 * 180.0 * t);
+        samples[i] = {static_cast<std::int64_t>(i) * period + 1, x + noise(rng), noise(rng), z + noise(rng)};
+    }
+    return samples;
+}
+
+// Zestaw reguł: domyślne + kopie z innymi progami i oknami (kilka okien współdzielonych)
+EventDetector::RuleSet makeRules(std::size_t count)
+{
+    EventDetector::RuleSet rules = EventDetector::defaultRules();
+    const EventDetector::Aggregate aggregates[] = {
+        EventDetector::Aggregate::Mean, EventDetector::Aggregate::Rms,
+        EventDetector::Aggregate::Peak, EventDetector::Aggregate::Min, EventDetector::Aggregate::Instant
+    };
+    for (std::size_t i = 0; rules.size() < count; ++i) {
+        EventDetector::Rule rule;
+        rule.name = "rule" + std::to_string(i);
+        rule.quantity = i % 3 == 2 ? EventDetector::Quantity::Jerk : EventDetector::Quantity::Magnitude;
+        rule.aggregate = aggregates[i % 5];
+        rule.windowNs = static_cast<std::int64_t>(50 + 50 * (i % 4)) * 1'000'000;
+        rule.threshold = rule.quantity == EventDetector::Quantity::Jerk ? 2000.0 + i : 2.0 + 0.1 * i;
+        rule.release = 0.8 * rule.threshold;
+        rule.holdNs = static_cast<std::int64_t>(i % 3) * 10'000'000;
+        rules.push_back(rule);
+    }
+    return rules;
+}
+
+struct Result
+{
+    double nsPerSample = 0.0;
+    std::size_t events = 0;
+};
+
+Result run(std::size_t streams, std::size_t ruleCount, const std::vector<AccSample>& flight)
+{
+    auto rules = std::make_shared<const EventDetector::RuleSet>(makeRules(ruleCount));
+    std::vector<std::unique_ptr<EventDetector>> detectors;
+    for (std::size_t s = 0; s < streams; ++s) {
+        detectors.push_back(std::make_unique<EventDetector>());
+        detectors.back()->setRules(rules);
+    }
+
+    Result result;
+    std::vector<EventDetector::Event> events;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t done = 0; done < flight.size(); done += BlockSize) {
+        const std::size_t count = std::min(BlockSize, flight.size() - done);
+        for (const std::unique_ptr<EventDetector>& detector : detectors) {
+            detector->process(flight.data() + done, count, events);
+            result.events += events.size();
+            events.clear();
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.nsPerSample = seconds * 1e9 / static_cast<double>(flight.size() * streams);
+    return result;
+}
+
+// Wykrycie zjawisk z lotu testowego i opóźnienie względem ich początku
+void checkDetection(const std::vector<AccSample>& flight)
+{
+    EventDetector detector;
+    detector.setRules(std::make_shared<const EventDetector::RuleSet>(EventDetector::defaultRules()));
+    std::vector<EventDetector::Event> events;
+    for (std::size_t done = 0; done < flight.size(); done += BlockSize)
+        detector.process(flight.data() + done, std::min(BlockSize, flight.size() - done), events);
+
+    const double expected[] = {20.0, 20.3, 50.0};
+    std::printf("%-12s %8s %12s %12s %10s\n", "rule", "kind", "onset [s]", "latency[ms]", "value");
+    for (const EventDetector::Event& event : events) {
+        const bool raised = event.kind == EventDetector::Event::Kind::Raised;
+        const double at = static_cast<double>(event.timestamp) / 1e9;
+        const double latency = raised && event.rule < 3 ? (at - expected[event.rule]) * 1e3 : 0.0;
+        std::printf("%-12s %8s %12.3f %12.1f %10.3f\n", event.name.c_str(), raised ? "raised" : "cleared",
+                    static_cast<double>(event.onset) / 1e9, latency, raised ? event.value : event.peak);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<AccSample> flight = makeFlight(42);
+    checkDetection(flight);
+
+    std::printf("\n%zu samples per stream at %.0f Hz, block %zu\n", flight.size(), SampleRate, BlockSize);
+    std::printf("%8s %8s %14s %16s %10s\n", "streams", "rules", "ns/sample", "samples/s/core", "events");
+    for (std::size_t streams : {1, 16}) {
+        for (std::size_t rules : {3, 12, 48}) {
+            const Result result = run(streams, rules, flight);
+            std::printf("%8zu %8zu %14.1f %16.0f %10zu\n", streams, rules, result.nsPerSample,
+                        1e9 / result.nsPerSample, result.events);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Eksport sesji: współczynnik kompresji oraz przepustowość kodowania i dekodowania [MB/s
+// danych nieskompresowanych, 32 B na próbkę], dla danych z modelu drona (pełna precyzja double)
+// i tych samych danych zaokrąglonych do float32, jak z portu szeregowego. Do tego pełny
+// SessionExporter (kolejka, wątek zapisu, plik). Wynik: JSON.
+
+#include "accsimulator.hpp"
+#include "sessionexporter.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t BlockSamples = 4096;
+
+QJsonObject measureCodec(const char* name, const std::vector<AccSample>& samples)
+{
+    const double rawBytes = static_cast<double>(samples.size() * sizeof(AccSample));
+    std::vector<std::uint8_t> encoded;
+    encoded.reserve(samples.size() * sizeof(AccSample));
+
+    QElapsedTimer timer;
+    timer.start();
+    for (std::size_t i = 0; i < samples.size(); i += BlockSamples)
+        SessionCodec::encodeBlock(0, samples.data() + i, std::min(BlockSamples, samples.size() - i), encoded);
+    const double encodeSeconds = timer.nsecsElapsed() / 1e9;
+
+    timer.restart();
+    SessionExportFormat::BlockHeader header;
+    std::vector<AccSample> decoded;
+    std::size_t pos = 0;
+    std::size_t index = 0;
+    bool identical = true;
+    while (pos < encoded.size()) {
+        std::size_t consumed = 0;
+        if (!SessionCodec::decodeBlock(encoded.data() + pos, encoded.size() - pos, header, decoded, consumed)) {
+            identical = false;
+            break;
+        }
+        identical = identical && std::memcmp(decoded.data(), samples.data() + index, decoded.size() * sizeof(AccSample)) == 0;
+        index += decoded.size();
+        pos += consumed;
+    }
+    const double decodeSeconds = timer.nsecsElapsed() / 1e9;
+
+    QJsonObject result;
+    result["data"] = name;
+    result["samples"] = static_cast<qint64>(samples.size());
+    result["compressionRatio"] = rawBytes / encoded.size();
+    result["bitsPerSample"] = encoded.size() * 8.0 / samples.size();
+    result["encodeMBps"] = rawBytes / encodeSeconds / 1e6;
+    result["decodeMBps"] = rawBytes / decodeSeconds / 1e6;
+    result["lossless"] = identical && index == samples.size();
+    std::fprintf(stderr, "%-8s ratio %.2f, encode %.0f MB/s, decode %.0f MB/s%s\n", name,
+                 rawBytes / encoded.size(), rawBytes / encodeSeconds / 1e6, rawBytes / decodeSeconds / 1e6,
+                 result["lossless"].toBool() ? "" : ", MISMATCH");
+    return result;
+}
+
+// Pełny eksporter: bloki tak jak z SimulationController::streamBlock, dla kilku strumieni
+QJsonObject measureExporter(const std::vector<AccSample>& samples, int streams)
+{
+    QTemporaryDir dir;
+    SessionExporter exporter;
+    exporter.start(dir.filePath("bench.accz"));
+
+    QElapsedTimer timer;
+    timer.start();
+    constexpr qsizetype TickSamples = 100;
+    for (std::size_t i = 0; i < samples.size(); i += TickSamples) {
+        const std::size_t end = std::min(samples.size(), i + TickSamples);
+        const AccSampleBlock block(samples.begin() + static_cast<std::ptrdiff_t>(i),
+                                   samples.begin() + static_cast<std::ptrdiff_t>(end));
+        for (int id = 0; id < streams; ++id)
+            exporter.record(id, block);
+    }
+    exporter.stop();
+    const double seconds = timer.nsecsElapsed() / 1e9;
+
+    const double rawBytes = static_cast<double>(exporter.exportedSamples() * sizeof(AccSample));
+    QJsonObject result;
+    result["streams"] = streams;
+    result["samples"] = static_cast<qint64>(exporter.exportedSamples());
+    result["dropped"] = static_cast<qint64>(exporter.droppedSamples());
+    result["fileBytes"] = static_cast<qint64>(exporter.bytesWritten());
+    result["compressionRatio"] = rawBytes / exporter.bytesWritten();
+    result["MBps"] = rawBytes / seconds / 1e6;
+    std::fprintf(stderr, "exporter %d streams: %.0f MB/s, dropped %llu\n", streams, rawBytes / seconds / 1e6,
+                 static_cast<unsigned long long>(exporter.droppedSamples()));
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption secondsOption("seconds", "Simulated flight time per stream [s].", "s", "120");
+    QCommandLineOption rateOption("rate", "Sample rate [Hz].", "hz", "1000");
+    QCommandLineOption streamsOption("streams", "Streams fed to the exporter.", "n", "8");
+    parser.addOptions({secondsOption, rateOption, streamsOption});
+    parser.process(app);
+
+    AccSimulator simulator;
+    simulator.setSampleRate(parser.value(rateOption).toDouble());
+    const AccSampleBlock generated = simulator.generate(
+        static_cast<qint64>(parser.value(rateOption).toDouble() * parser.value(secondsOption).toDouble()));
+    std::vector<AccSample> samples(generated.begin(), generated.end());
+    std::vector<AccSample> quantized = samples;
+    for (AccSample& sample : quantized) {
+        sample.x = static_cast<float>(sample.x);
+        sample.y = static_cast<float>(sample.y);
+        sample.z = static_cast<float>(sample.z);
+    }
+
+    QJsonArray codec;
+    codec.append(measureCodec("double", samples));
+    codec.append(measureCodec("float32", quantized));
+
+    QJsonObject report;
+    report["benchmark"] = "export";
+    report["rateHz"] = parser.value(rateOption).toDouble();
+    report["codec"] = codec;
+    report["exporter"] = measureExporter(quantized, parser.value(streamsOption).toInt());
+    const QByteArray json = QJsonDocument(report).toJson();
+    std::fwrite(json.constData(), 1, static_cast<std::size_t>(json.size()), stdout);
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Benchmark całego toru danych bez ekranu (QT_QPA_PLATFORM=offscreen):
+// SimulationController -> SpinBoxController / TelemetryStore -> ChartWindow.
+// Dla kolejnych częstotliwości próbkowania mierzy przepustowość, straty próbek
+// i opóźnienie od wygenerowania próbki do najbliższego rysowania wykresu. Wynik: JSON.
+// --streams N uruchamia N symulowanych czujników naraz; czas procesora wątku GUI
+// i całego procesu pokazuje, jak koszt rośnie z liczbą strumieni.
+
+#include "SpinBoxController.hpp"
+#include "chartwindow.hpp"
+#include "cputime.hpp"
+#include "simulationcontroller.hpp"
+#include "telemetrystore.hpp"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDoubleSpinBox>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+namespace {
+
+struct RunResult
+{
+    double rate = 0.0;
+    double seconds = 0.0;
+    qint64 delivered = 0;
+    quint64 dropped = 0;
+    qint64 frames = 0;
+    int streams = 1;
+    double guiCpuSeconds = 0.0;     ///< Czas procesora wątku GUI w trakcie pomiaru.
+    double processCpuSeconds = 0.0; ///< Czas procesora wszystkich wątków w trakcie pomiaru.
+    std::vector<qint64> latencies; ///< Opóźnienia próbek [ns] (strumień 0).
+};
+
+void runEventLoop(int ms)
+{
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+double percentileMs(std::vector<qint64>& values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    const std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index] / 1e6;
+}
+
+RunResult runAtRate(double rate, int durationMs, int streams)
+{
+    RunResult result;
+    result.rate = rate;
+    result.streams = streams;
+
+    SimulationController controller;
+    controller.setSampleRate(rate);
+    controller.setSimulatedStreams(streams);
+    QDoubleSpinBox boxX, boxY, boxZ;
+    boxX.setRange(-10.0, 10.0);
+    boxY.setRange(-10.0, 10.0);
+    boxZ.setRange(-10.0, 10.0);
+    SpinBoxController spinController(&boxX, &boxY, &boxZ);
+    // Osobny magazyn na każdy przebieg – bez historii z poprzednich częstotliwości
+    TelemetryStore store;
+    for (int id : controller.streamIds())
+        store.addSeries(id, controller.streamName(id));
+    ChartWindow chart(nullptr, &store);
+    chart.resize(1200, 750);
+    chart.show();
+
+    // Znaczniki czasu próbek, które dotarły do GUI, a nie zostały jeszcze narysowane
+    std::deque<qint64> pending;
+    QObject::connect(&controller, &SimulationController::newBlock, &spinController, &SpinBoxController::updateBlock);
+    // Jak w MainWindow: magazyn dostaje bloki w wątkach puli, więc licznik też jest tam aktualizowany
+    std::atomic<qint64> delivered{0};
+    QObject::connect(&controller, &SimulationController::streamBlock, &store, &TelemetryStore::append,
+                     Qt::DirectConnection);
+    QObject::connect(&controller, &SimulationController::intervalReset, &store, &TelemetryStore::resetInterval,
+                     Qt::DirectConnection);
+    QObject::connect(&controller, &SimulationController::streamBlock, [&](int, const AccSampleBlock& block) {
+        delivered.fetch_add(block.size(), std::memory_order_relaxed);
+    });
+    QObject::connect(&controller, &SimulationController::newBlock, [&](const AccSampleBlock& block) {
+        for (const AccSample& sample : block)
+            pending.push_back(sample.timestamp);
+    });
+    QObject::connect(&chart, &ChartWindow::framePainted, [&](qint64 newestTimestamp) {
+        const qint64 now = accTimestampNow();
+        ++result.frames;
+        while (!pending.empty() && pending.front() <= newestTimestamp) {
+            result.latencies.push_back(now - pending.front());
+            pending.pop_front();
+        }
+    });
+
+    runEventLoop(200); // Pierwsze rysowanie okna poza pomiarem
+    QElapsedTimer timer;
+    timer.start();
+    const double guiCpuStart = CpuTime::threadSeconds();
+    const double processCpuStart = CpuTime::processSeconds();
+    controller.startSimulation();
+    runEventLoop(durationMs);
+    controller.stopSimulation();
+    result.seconds = timer.nsecsElapsed() / 1e9;
+    result.guiCpuSeconds = CpuTime::threadSeconds() - guiCpuStart;
+    result.processCpuSeconds = CpuTime::processSeconds() - processCpuStart;
+    runEventLoop(100); // Dokończenie bloków będących w kolejce
+    result.dropped = controller.droppedSamples();
+    result.delivered = delivered.load();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption durationOption("duration", "Measurement time per rate [ms].", "ms", "3000");
+    QCommandLineOption ratesOption("rates", "Comma separated sample rates [Hz].", "list", "100,500,1000,2000,5000,10000");
+    QCommandLineOption streamsOption("streams", "Number of simulated sensors running at once.", "count", "1");
+    QCommandLineOption outputOption("output", "Write JSON to file instead of stdout.", "file");
+    parser.addOptions({durationOption, ratesOption, streamsOption, outputOption});
+    parser.process(app);
+
+    const int durationMs = parser.value(durationOption).toInt();
+    const int streams = std::max(1, parser.value(streamsOption).toInt());
+    QJsonArray runs;
+    QJsonValue dropOnset;
+    for (const QString& rateText : parser.value(ratesOption).split(',', Qt::SkipEmptyParts)) {
+        RunResult run = runAtRate(rateText.toDouble(), durationMs, streams);
+        const double expected = run.rate * run.seconds * run.streams;
+        const double dropRatio = expected > 0.0 ? 1.0 - std::min(1.0, run.delivered / expected) : 0.0;
+
+        QJsonObject latency;
+        latency["samples"] = static_cast<qint64>(run.latencies.size());
+        latency["p50"] = percentileMs(run.latencies, 0.50);
+        latency["p90"] = percentileMs(run.latencies, 0.90);
+        latency["p99"] = percentileMs(run.latencies, 0.99);
+        latency["max"] = run.latencies.empty() ? 0.0 : *std::max_element(run.latencies.begin(), run.latencies.end()) / 1e6;
+
+        QJsonObject entry;
+        entry["rateHz"] = run.rate;
+        entry["streams"] = run.streams;
+        entry["seconds"] = run.seconds;
+        entry["deliveredSamples"] = run.delivered;
+        entry["droppedSamples"] = static_cast<qint64>(run.dropped);
+        entry["dropRatio"] = dropRatio;
+        entry["sustainedSamplesPerSecond"] = run.delivered / run.seconds;
+        entry["paintedFrames"] = run.frames;
+        entry["latencyMs"] = latency;
+        entry["guiCpuPercent"] = 100.0 * run.guiCpuSeconds / run.seconds;
+        entry["processCpuPercent"] = 100.0 * run.processCpuSeconds / run.seconds;
+        runs.append(entry);
+
+        // Pierwsza częstotliwość, przy której ginie więcej niż 0,1% próbek
+        if (dropOnset.isNull() && (run.dropped > 0 || dropRatio > 0.001))
+            dropOnset = run.rate;
+        std::fprintf(stderr, "%8.0f Hz: %.0f S/s, dropped %llu, p99 %.1f ms\n", run.rate,
+                     run.delivered / run.seconds, static_cast<unsigned long long>(run.dropped), latency["p99"].toDouble());
+    }
+
+    QJsonObject report;
+    report["benchmark"] = "pipeline";
+    report["platform"] = QString::fromLocal8Bit(qgetenv("QT_QPA_PLATFORM"));
+    report["durationMsPerRate"] = durationMs;
+    report["streams"] = streams;
+    report["dropOnsetRateHz"] = dropOnset;
+    report["runs"] = runs;
+
+    const QByteArray json = QJsonDocument(report).toJson();
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly)) {
+            std::fprintf(stderr, "Cannot write %s\n", qPrintable(parser.value(outputOption)));
+            return 1;
+        }
+        file.write(json);
+    } else {
+        std::fwrite(json.constData(), 1, static_cast<std::size_t>(json.size()), stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Tryb wsadowy symulatora: ile trwa policzenie zadanego czasu lotu i czy powtórzenie
+// z tym samym ziarnem daje identyczne bity (skrót FNV-1a całego przebiegu). Wynik: JSON.
+
+#include "accsimulator.hpp"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct BatchResult
+{
+    double milliseconds = 0.0;
+    quint64 hash = 0;
+    qint64 samples = 0;
+};
+
+BatchResult runBatch(quint64 seed, double rate, double seconds)
+{
+    AccSimulator simulator;
+    simulator.setSeed(seed);
+    simulator.setSampleRate(rate);
+
+    BatchResult result;
+    result.hash = 1469598103934665603ULL;
+    const qint64 total = static_cast<qint64>(rate * seconds);
+    QElapsedTimer timer;
+    timer.start();
+    // Stałe porcje – wynik nie może zależeć od podziału na bloki
+    while (result.samples < total) {
+        const AccSampleBlock block = simulator.generate(std::min<qint64>(AccSimulator::BatchBlockSamples, total - result.samples));
+        for (const AccSample& sample : block) {
+            unsigned char bytes[sizeof(AccSample)];
+            std::memcpy(bytes, &sample, sizeof(AccSample));
+            for (unsigned char byte : bytes)
+                result.hash = (result.hash ^ byte) * 1099511628211ULL;
+        }
+        result.samples += block.size();
+    }
+    result.milliseconds = timer.nsecsElapsed() / 1e6;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption secondsOption("seconds", "Simulated flight time [s].", "s", "600");
+    QCommandLineOption rateOption("rate", "Sample rate [Hz].", "hz", "1000");
+    QCommandLineOption seedOption("seed", "Model seed.", "seed", "1");
+    parser.addOptions({secondsOption, rateOption, seedOption});
+    parser.process(app);
+
+    const double seconds = parser.value(secondsOption).toDouble();
+    const double rate = parser.value(rateOption).toDouble();
+    const quint64 seed = parser.value(seedOption).toULongLong();
+
+    const BatchResult first = runBatch(seed, rate, seconds);
+    const BatchResult second = runBatch(seed, rate, seconds);
+    const bool identical = first.hash == second.hash && first.samples == second.samples;
+
+    QJsonObject report;
+    report["benchmark"] = "simulator";
+    report["seed"] = QString::number(seed);
+    report["rateHz"] = rate;
+    report["simulatedSeconds"] = seconds;
+    report["samples"] = first.samples;
+    report["milliseconds"] = first.milliseconds;
+    report["speedupOverRealTime"] = first.milliseconds > 0.0 ? seconds * 1000.0 / first.milliseconds : 0.0;
+    report["hash"] = QString::number(first.hash, 16);
+    report["reproducible"] = identical;
+    const QByteArray json = QJsonDocument(report).toJson();
+    std::fwrite(json.constData(), 1, static_cast<std::size_t>(json.size()), stdout);
+    std::fprintf(stderr, "%.0f s @ %.0f Hz in %.1f ms, %s\n", seconds, rate, first.milliseconds,
+                 identical ? "bit-identical" : "NOT reproducible");
+    return identical ? 0 : 1;
+}
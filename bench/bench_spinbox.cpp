@@ -0,0 +1,118 @@
+// Koszt odczytów SpinBoxController w wątku GUI (QT_QPA_PLATFORM=offscreen).
+// Bloki próbek przychodzą co 10 ms, jak z SimulationController. Porównanie:
+//  - perSample: trzy wywołania QDoubleSpinBox::setValue() na każdą próbkę (dawny updateAll),
+//  - coalesced: SpinBoxController zbierający próbki i odświeżający pola w takcie 10 Hz.
+// Miarą jest czas procesora wątku GUI na sekundę pomiaru. Wynik: JSON.
+
+#include "SpinBoxController.hpp"
+#include "cputime.hpp"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDoubleSpinBox>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <QHBoxLayout>
+#include <QWidget>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+namespace {
+
+// Wątek GUI przez durationMs dostaje blok co 10 ms; zwraca udział czasu procesora [%]
+double measure(double rate, int durationMs, const std::function<void(const AccSampleBlock&)>& deliver)
+{
+    const int blockSamples = std::max(1, static_cast<int>(rate / 100.0));
+    AccSampleBlock block(blockSamples);
+    qint64 n = 0;
+
+    QTimer producer;
+    producer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&producer, &QTimer::timeout, [&]() {
+        for (AccSample& sample : block) {
+            sample = {accTimestampNow(), std::sin(n * 0.01), std::cos(n * 0.01), (n % 100) * 0.01};
+            ++n;
+        }
+        deliver(block);
+    });
+
+    QEventLoop loop;
+    QTimer::singleShot(durationMs, &loop, &QEventLoop::quit);
+    QElapsedTimer wall;
+    wall.start();
+    const double cpuStart = CpuTime::threadSeconds();
+    producer.start(10);
+    loop.exec();
+    producer.stop();
+    return 100.0 * (CpuTime::threadSeconds() - cpuStart) / (wall.nsecsElapsed() / 1e9);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption durationOption("duration", "Measurement time per rate and variant [ms].", "ms", "2000");
+    QCommandLineOption ratesOption("rates", "Comma separated sample rates [Hz].", "list", "100,1000,5000,10000");
+    parser.addOptions({durationOption, ratesOption});
+    parser.process(app);
+    const int durationMs = parser.value(durationOption).toInt();
+
+    QWidget window;
+    QHBoxLayout* layout = new QHBoxLayout(&window);
+    QDoubleSpinBox* boxes[3];
+    for (QDoubleSpinBox*& box : boxes) {
+        box = new QDoubleSpinBox(&window);
+        box->setRange(-10.0, 10.0);
+        box->setDecimals(3);
+        layout->addWidget(box);
+    }
+    window.show();
+
+    QJsonArray runs;
+    for (const QString& rateText : parser.value(ratesOption).split(',', Qt::SkipEmptyParts)) {
+        const double rate = rateText.toDouble();
+
+        const double perSample = measure(rate, durationMs, [&](const AccSampleBlock& block) {
+            for (const AccSample& sample : block) {
+                boxes[0]->setValue(sample.x);
+                boxes[1]->setValue(sample.y);
+                boxes[2]->setValue(sample.z);
+            }
+        });
+
+        double coalesced = 0.0;
+        {
+            SpinBoxController controller(boxes[0], boxes[1], boxes[2]);
+            controller.setMode(SpinBoxController::Mode::Average);
+            coalesced = measure(rate, durationMs, [&](const AccSampleBlock& block) {
+                controller.updateBlock(block);
+            });
+        }
+
+        QJsonObject entry;
+        entry["rateHz"] = rate;
+        entry["perSampleGuiCpuPercent"] = perSample;
+        entry["coalescedGuiCpuPercent"] = coalesced;
+        runs.append(entry);
+        std::fprintf(stderr, "%8.0f Hz: per-sample %.1f%%, coalesced %.1f%% GUI CPU\n", rate, perSample, coalesced);
+    }
+
+    QJsonObject report;
+    report["benchmark"] = "spinbox";
+    report["durationMsPerRun"] = durationMs;
+    report["runs"] = runs;
+    const QByteArray json = QJsonDocument(report).toJson();
+    std::fwrite(json.constData(), 1, static_cast<std::size_t>(json.size()), stdout);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef BENCH_CPUTIME_HPP
+#define BENCH_CPUTIME_HPP
+
+// Czas procesora dla programów pomiarowych: bieżącego wątku (zwykle wątku GUI) i całego procesu.
+// Windows: GetThreadTimes/GetProcessTimes, pozostałe systemy: clock_gettime.
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX   // min/max z windows.h psułyby std::min/std::max
+#endif
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+namespace CpuTime {
+
+#ifdef _WIN32
+// Czas jądra + użytkownika z FILETIME (jednostki 100 ns)
+inline double fileTimeSeconds(const FILETIME& kernel, const FILETIME& user)
+{
+    const auto ticks = [](const FILETIME& time) {
+        return (static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return (ticks(kernel) + ticks(user)) / 1e7;
+}
+
+inline double threadSeconds()
+{
+    FILETIME creation, exit, kernel, user;
+    GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+    return fileTimeSeconds(kernel, user);
+}
+
+inline double processSeconds()
+{
+    FILETIME creation, exit, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+    return fileTimeSeconds(kernel, user);
+}
+#else
+inline double clockSeconds(clockid_t clock)
+{
+    timespec ts{};
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+inline double threadSeconds()
+{
+    return clockSeconds(CLOCK_THREAD_CPUTIME_ID);
+}
+
+inline double processSeconds()
+{
+    return clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+}
+#endif
+
+} // namespace CpuTime
+
+#endif // BENCH_CPUTIME_HPP
@@ -1,14 +1,27 @@
 #ifndef SPINBOXCONTROLLER_HPP
 #define SPINBOXCONTROLLER_HPP
 
+#include "accsampleblock.hpp"
 #include <QObject>
 #include <QDoubleSpinBox>
+#include <QTimer>
 
+/**
+ * @brief Odczyt wartości trzech osi w polach QDoubleSpinBox.
+ *
+ * Próbki są tylko zbierane (najnowsza oraz min/suma/max z bieżącego przedziału),
+ * a pola są odświeżane w stałym takcie wyświetlania – koszt w wątku GUI nie
+ * rośnie z częstotliwością próbkowania. Opcjonalne podtrzymanie szczytu pokazuje
+ * największą co do modułu wartość z ostatnich peakHoldMs milisekund.
+ */
 class SpinBoxController : public QObject
 {
     Q_OBJECT
 
 public:
+    // Co pokazać z próbek zebranych w jednym takcie wyświetlania
+    enum class Mode { Latest, Minimum, Average, Maximum };
+
     explicit SpinBoxController(QDoubleSpinBox* boxX,
                                QDoubleSpinBox* boxY,
                                QDoubleSpinBox* boxZ,
@@ -16,15 +29,45 @@ public:
                                double initialY = 0.0,
                                double initialZ = 0.0);
 
+    void setMode(Mode mode);
+    Mode mode() const { return m_mode; }
+    // Takt odświeżania pól [ms]; domyślnie 100 ms (10 Hz)
+    void setDisplayInterval(int ms);
+    // holdMs == 0 wyłącza podtrzymanie szczytu
+    void setPeakHold(int holdMs);
+
 public slots:
     void updateAll(double x, double y, double z);
+    void updateBlock(const AccSampleBlock& block);
+
+private slots:
+    void refreshDisplay();
 
 private:
+    struct Accumulator
+    {
+        double latest = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        double peak = 0.0;      ///< Największa co do modułu wartość w oknie podtrzymania.
+        qint64 peakTime = 0;    ///< Chwila zapisania szczytu [ms, zegar monotoniczny].
+
+        void add(double value, bool first);
+        double value(Mode mode, qint64 count) const;
+    };
+
+    void accumulate(double x, double y, double z);
     void updateDisplay(QDoubleSpinBox* box, double value);
 
     QDoubleSpinBox* m_boxX;
     QDoubleSpinBox* m_boxY;
     QDoubleSpinBox* m_boxZ;
+    Accumulator m_axes[3];
+    qint64 m_count = 0;             ///< Próbki zebrane od ostatniego odświeżenia.
+    Mode m_mode = Mode::Latest;
+    int m_peakHoldMs = 0;
+    QTimer* m_displayTimer;
 };
 
 #endif // SPINBOXCONTROLLER_HPP
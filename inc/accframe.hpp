@@ -0,0 +1,89 @@
+#ifndef ACCFRAME_HPP
+#define ACCFRAME_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Binarna ramka akcelerometru przesyłana przez port szeregowy.
+ *
+ * Układ ramki (little-endian, 22 bajty):
+ *  - 2 B  synchronizacja 0xA5 0x5A,
+ *  - 2 B  numer sekwencyjny (uint16),
+ *  - 4 B  czas urządzenia w mikrosekundach (uint32),
+ *  - 12 B przyspieszenia X, Y, Z (float32, w g),
+ *  - 2 B  CRC-16/CCITT-FALSE liczone od numeru sekwencyjnego do końca danych.
+ */
+struct AccFrame
+{
+    std::uint16_t sequence;
+    std::uint32_t deviceTimeUs;
+    float x;
+    float y;
+    float z;
+};
+
+namespace AccFrameFormat {
+constexpr std::uint8_t Sync0 = 0xA5;
+constexpr std::uint8_t Sync1 = 0x5A;
+constexpr std::size_t FrameSize = 22;
+}
+
+// CRC-16/CCITT-FALSE (wielomian 0x1021, wartość początkowa 0xFFFF)
+std::uint16_t accCrc16(const std::uint8_t* data, std::size_t size);
+
+// Serializacja ramki do postaci binarnej – używana przez symulatory urządzenia i testy na pty
+void encodeAccFrame(const AccFrame& frame, std::uint8_t out[AccFrameFormat::FrameSize]);
+
+/**
+ * @brief Strumieniowy parser ramek z kontrolą CRC i resynchronizacją.
+ *
+ * Bajty można podawać w dowolnych porcjach; niepełna ramka czeka na kolejne dane.
+ * Po błędzie CRC parser odrzuca jeden bajt i szuka następnego znacznika synchronizacji.
+ */
+class AccFrameParser
+{
+public:
+    struct Stats
+    {
+        std::uint64_t frames = 0;        ///< Poprawnie zdekodowane ramki.
+        std::uint64_t crcErrors = 0;     ///< Ramki odrzucone z powodu błędnego CRC.
+        std::uint64_t skippedBytes = 0;  ///< Bajty pominięte podczas resynchronizacji.
+        std::uint64_t lostFrames = 0;    ///< Ramki brakujące wg numeru sekwencyjnego.
+    };
+
+    AccFrameParser();
+
+    // Przetworzenie porcji bajtów; dla każdej poprawnej ramki wywoływane jest onFrame(const AccFrame&)
+    template <typename Callback>
+    void feed(const std::uint8_t* data, std::size_t size, Callback&& onFrame)
+    {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+
+        std::size_t pos = 0;
+        AccFrame frame;
+        while (m_buffer.size() - pos >= AccFrameFormat::FrameSize) {
+            if (tryDecode(m_buffer.data() + pos, frame)) {
+                onFrame(frame);
+                pos += AccFrameFormat::FrameSize;
+            } else {
+                ++pos;
+            }
+        }
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+
+    void reset();
+    const Stats& stats() const { return m_stats; }
+
+private:
+    bool tryDecode(const std::uint8_t* data, AccFrame& frame);
+
+    std::vector<std::uint8_t> m_buffer;
+    Stats m_stats;
+    bool m_haveSequence = false;
+    std::uint16_t m_lastSequence = 0;
+};
+
+#endif // ACCFRAME_HPP
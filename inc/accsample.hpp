@@ -0,0 +1,28 @@
+#ifndef ACCSAMPLE_HPP
+#define ACCSAMPLE_HPP
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Pojedyncza próbka akcelerometru ze znacznikiem czasu.
+ *
+ * Struktura typu POD – można ją kopiować memcpy i przechowywać w buforach
+ * bez alokacji na stercie.
+ */
+struct AccSample
+{
+    std::int64_t timestamp; ///< Czas monotoniczny w nanosekundach (accTimestampNow()).
+    double x;               ///< Przyspieszenie w osi X [g].
+    double y;               ///< Przyspieszenie w osi Y [g].
+    double z;               ///< Przyspieszenie w osi Z [g].
+};
+
+// Bieżący czas monotoniczny w nanosekundach – wspólna podstawa czasu dla wszystkich źródeł
+inline std::int64_t accTimestampNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // ACCSAMPLE_HPP
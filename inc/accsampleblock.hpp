@@ -0,0 +1,19 @@
+#ifndef ACCSAMPLEBLOCK_HPP
+#define ACCSAMPLEBLOCK_HPP
+
+#include "accsample.hpp"
+#include <QMetaType>
+#include <QVector>
+
+/**
+ * @brief Ciągły blok próbek przekazywany między wątkami jednym sygnałem.
+ *
+ * QVector jest współdzielony niejawnie, więc kolejkowane połączenie kopiuje tylko
+ * uchwyt. Odbiorcy dostają referencję do stałej i nie modyfikują bloku – dzięki temu
+ * ten sam bufor trafia do wszystkich konsumentów bez kopiowania danych.
+ */
+using AccSampleBlock = QVector<AccSample>;
+
+Q_DECLARE_METATYPE(AccSample)
+
+#endif // ACCSAMPLEBLOCK_HPP
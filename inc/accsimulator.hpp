@@ -1,30 +1,69 @@
 #ifndef ACCSIMULATOR_HPP
 #define ACCSIMULATOR_HPP
 
-#include <QObject>
-#include <QTimer>
+#include "dronemodel.hpp"
+#include "samplesource.hpp"
+#include <atomic>
 
-class AccSimulator : public QObject
+/**
+ * @brief Symulator akcelerometru drona generujący próbki blokami.
+ *
+ * Wartości pochodzą z deterministycznego modelu DroneModel z własnym generatorem
+ * liczb losowych: to samo ziarno i ta sama częstotliwość dają identyczne bity,
+ * niezależnie od tego, kiedy i w jakich porcjach próbki są pobierane.
+ *
+ * Pod kontrolerem próbki są wyliczane w poll() z czasu, który upłynął od startu.
+ * Poza zegarem działa tylko tryb wsadowy: generate() liczy dowolną liczbę próbek od razu
+ * (scenariusze wsadowe, testy obciążeniowe). Metody start()/stop()/setSampleRate()/
+ * setSeed() można wywoływać z dowolnego wątku – zmiany są przejmowane przy najbliższym poll().
+ */
+class AccSimulator : public SampleSource
 {
     Q_OBJECT
 
 public:
 
+    static constexpr double MaxSampleRate = 10000.0;
+    static constexpr qint64 BatchBlockSamples = 16384; ///< Zalecana porcja generate() w trybie wsadowym.
+
     explicit AccSimulator(QObject *parent = nullptr);
-    void start();
-    void stop();
-    bool isRunning() const;
+    void start() override;
+    void stop() override;
+    bool isRunning() const override;
+    AccSampleBlock poll(std::int64_t now) override;
+
+    // Częstotliwość próbkowania w Hz, z zakresu (0, MaxSampleRate]
+    void setSampleRate(double hz);
+    double sampleRate() const;
 
-signals:
-    void newData(double x, double y, double z);
+    // Ziarno modelu; każdy start() zaczyna przebieg od początku dla bieżącego ziarna
+    void setSeed(quint64 seed);
+    quint64 seed() const;
 
-private slots:
-    void generateData();
+    // Tryb wsadowy: kolejne count próbek od razu, znaczniki czasu od 0 przy pierwszym wywołaniu.
+    // Nie łączyć z pracą pod kontrolerem (ten sam stan co poll()).
+    AccSampleBlock generate(qint64 count);
+
+    // Liczba próbek pominiętych, bo symulator nie był odpytywany wystarczająco często
+    quint64 droppedSamples() const;
 
 private:
-    QTimer *timer;
-    bool running = false;
-    double randomInRange(double min, double max);
+    void applyRequests(std::int64_t anchor);
+    void fill(AccSampleBlock& block);
+    void skip(qint64 count);
+
+    std::atomic<bool> running{false};
+    std::atomic<bool> restart{false};  ///< Start lub zmiana częstotliwości – nowa siatka czasu.
+    std::atomic<bool> reseed{true};    ///< Start lub zmiana ziarna – model od początku.
+    std::atomic<double> rate{20.0};
+    std::atomic<quint64> seedValue{1};
+    std::atomic<quint64> dropped{0};
+    DroneModel model;
+    double activeRate = 20.0;         ///< Częstotliwość, dla której liczona jest bieżąca siatka.
+    bool anchored = false;            ///< Czy siatka czasu ma już punkt startowy.
+    std::int64_t startTime = 0;       ///< Czas startu generowania [ns].
+    qint64 emittedSamples = 0;        ///< Liczba próbek wygenerowanych od startu.
+    const double maxBacklogSeconds = 0.5; ///< Większe zaległości są porzucane, a nie nadrabiane.
 };
 
 #endif // ACCSIMULATOR_HPP
@@ -1,35 +1,112 @@
 #ifndef CHARTWINDOW_HPP
 #define CHARTWINDOW_HPP
 
+#include "accsampleblock.hpp"
+#include "rasterstripchart.hpp"
+#include "telemetrystore.hpp"
 #include <QWidget>
 #include <QtCharts>
 #include <QChartView>
+#include <QComboBox>
+#include <QGridLayout>
+#include <QStackedWidget>
+#include <QTimer>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class ChartWindow; }
 QT_END_NAMESPACE
+
+/**
+ * @brief Siatka wykresów serii z TelemetryStore – jeden wykres (osie X, Y, Z) na strumień.
+ *
+ * Okno nie przechowuje danych: przy otwarciu pokazuje od razu całą historię z magazynu,
+ * a potem tylko odnotowuje nowe próbki i odświeża się w rytmie wyświetlania.
+ * Oś czasu to znaczniki próbek, a przerwy wykryte przez magazyn są zacieniowane.
+ */
 class ChartWindow : public QWidget {
     Q_OBJECT
 
 public:
-    explicit ChartWindow(QWidget *parent = nullptr);
+    // Sposób rysowania: QtCharts (scena graficzna, antyaliasing) albo RasterStripChart (obraz przewijany)
+    enum class Renderer { Charts, Raster };
+
+    // store == nullptr – magazyn wspólny dla procesu (TelemetryStore::instance()).
+    // deferred – wykresy istniejących serii powstają dopiero w buildStep() albo przy pokazaniu okna.
+    explicit ChartWindow(QWidget *parent = nullptr, TelemetryStore *store = nullptr, bool deferred = false);
 
     ~ChartWindow();
 
-public slots:
-    void updateData(double x, double y, double z);
+    // Budowa w tle: jeden wykres siatki z jednym pierwszym renderowaniem; false – okno gotowe
+    bool buildStep();
+
+    void setRenderer(Renderer renderer);
+    Renderer renderer() const { return activeRenderer; }
+
+signals:
+    // Początek rysowania klatki, na której widać już próbkę o podanym znaczniku czasu [ns]
+    void framePainted(qint64 newestTimestamp);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void addStream(int streamId, const QString &name);
+    void removeStream(int streamId);
+    void markDirty(int streamId, qint64 lastTimestamp);
+    void resetStream(int streamId);
+    void refresh();
+    void setWindowLength(int index);
 
 private:
-    void setupChart(int index, const QString &title);
-    void addData(float x, float y, float z);
+    struct StreamPlot
+    {
+        int id;
+        QStackedWidget* cell;                      ///< Komórka siatki: view albo raster.
+        QChartView* view;
+        RasterStripChart* raster;
+        QLineSeries* series[3];
+        QAreaSeries* gapArea;                      ///< Cień przerw w danych (między gapUpper i gapLower).
+        QLineSeries* gapUpper;
+        QLineSeries* gapLower;
+        QValueAxis* axisX;
+        QValueAxis* axisY;
+        bool dirty = false;                        ///< Czy od ostatniego odświeżenia coś się zmieniło.
+        qint64 lastTimestamp = 0;                  ///< Znacznik czasu najnowszej próbki w magazynie.
+        qint64 rasterTimestamp = 0;                ///< Najnowsza próbka przekazana do wykresu rastrowego.
+    };
+
+    StreamPlot* findPlot(int streamId);
+    void relayout();
+    void refreshPlot(StreamPlot &plot);
+    void rebuildRaster(StreamPlot &plot);
+    void updateGaps(StreamPlot &plot, double start, double end);
+    // Przerwy magazynu z widocznego przedziału [s] do bufora gapSpans
+    void collectGaps(int streamId, double start, double end);
+    // Widoczny przedział [s]; false, gdy seria jest pusta
+    bool visibleRange(int streamId, double &start, double &end) const;
 
     Ui::ChartWindow *ui;
-    QChartView* chartViews[3];
-    QLineSeries* series[3];
-    QValueAxis* axisX[3];
-    QValueAxis* axisY[3];
-    int sampleCount = 0;
-    const int maxSamples = 300; // 15s / 0.05s
-    float getCurrentTime() const;
+    TelemetryStore* store;
+    QComboBox* windowCombo;
+    QComboBox* rendererCombo;
+    QGridLayout* grid;
+    std::vector<std::unique_ptr<StreamPlot>> plots; ///< Kolejność = kolejność w siatce.
+    std::vector<int> pendingStreams;             ///< Serie czekające na wykres (budowa odroczona).
+    std::vector<MinMaxPyramid::Bucket> buckets;  ///< Bufor roboczy zapytań do historii.
+    std::vector<MinMaxPyramid::Bucket> rasterBuckets[3]; ///< Bufory przebudowy obrazu rastrowego.
+    std::vector<AccSample> newSamples;           ///< Bufor roboczy próbek dla wykresu rastrowego.
+    std::vector<TelemetryStore::Gap> gaps;       ///< Bufor roboczy zapytań o przerwy.
+    std::vector<std::pair<double, double>> gapSpans; ///< Przerwy widocznego przedziału [s].
+    QList<QPointF> points;                       ///< Bufor roboczy dla hurtowego replace().
+    Renderer activeRenderer = Renderer::Charts;
+    QTimer* refreshTimer;
+    qint64 shownTimestamp = 0;                   ///< Znacznik czasu najnowszej próbki pierwszego wykresu na ekranie.
+    int refreshesSincePaint = 0;                 ///< Odświeżenia danych, których nie zdążono narysować.
+    double windowSeconds = 15.0;                 ///< Długość widocznego okna; 0 = cała historia.
+    const int refreshIntervalMs = 33; // ~30 Hz, niezależnie od częstotliwości próbek
 };
 #endif // CHARTWINDOW_HPP
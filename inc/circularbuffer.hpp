@@ -0,0 +1,67 @@
+#ifndef CIRCULARBUFFER_HPP
+#define CIRCULARBUFFER_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bufor cykliczny o stałej pojemności (jednowątkowy).
+ *
+ * push() kosztuje O(1) i po zapełnieniu nadpisuje najstarszy element, więc
+ * nie ma przesuwania danych jak przy usuwaniu z początku wektora.
+ * Element 0 to najstarszy zachowany element.
+ */
+template <typename T>
+class CircularBuffer
+{
+public:
+    explicit CircularBuffer(std::size_t capacity = 0)
+        : m_data(capacity)
+    {
+    }
+
+    void push(const T& value)
+    {
+        if (m_data.empty())
+            return;
+        m_data[m_head] = value;
+        m_head = (m_head + 1 == m_data.size()) ? 0 : m_head + 1;
+        if (m_size < m_data.size())
+            ++m_size;
+    }
+
+    // Dostęp do i-tego elementu licząc od najstarszego
+    const T& operator[](std::size_t index) const
+    {
+        std::size_t pos = m_head + m_data.size() - m_size + index;
+        if (pos >= m_data.size())
+            pos -= m_data.size();
+        return m_data[pos];
+    }
+
+    const T& back() const { return (*this)[m_size - 1]; }
+    const T& front() const { return (*this)[0]; }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    void setCapacity(std::size_t capacity)
+    {
+        m_data.assign(capacity, T());
+        clear();
+    }
+
+    std::size_t size() const { return m_size; }
+    std::size_t capacity() const { return m_data.size(); }
+    bool empty() const { return m_size == 0; }
+
+private:
+    std::vector<T> m_data;
+    std::size_t m_head = 0; ///< Pozycja, pod którą trafi następny element.
+    std::size_t m_size = 0;
+};
+
+#endif // CIRCULARBUFFER_HPP
@@ -0,0 +1,77 @@
+#ifndef DRONEMODEL_HPP
+#define DRONEMODEL_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Generator xoshiro256** z własnym rozkładem normalnym.
+ *
+ * Stan należy do instancji (bez blokad, w przeciwieństwie do QRandomGenerator::global()),
+ * a rozkład normalny jest liczony tutaj, a nie przez std::normal_distribution, którego
+ * wynik zależy od implementacji biblioteki – ten sam ziarno daje więc te same bity.
+ */
+class Xoshiro256
+{
+public:
+    explicit Xoshiro256(std::uint64_t seed = 0);
+
+    void seed(std::uint64_t seed);
+    std::uint64_t next();
+    // Rozkład jednostajny na [0, 1)
+    double uniform();
+    // Rozkład normalny N(0, 1) – metoda biegunowa Marsaglii
+    double normal();
+
+private:
+    std::uint64_t s[4];
+    double spare = 0.0;
+    bool hasSpare = false;
+};
+
+// Parametry modelu DroneModel
+struct DroneParameters
+{
+    double dragCoefficient = 0.35;  ///< Opór liniowy [1/s].
+    double rotorHz = 110.0;         ///< Częstotliwość obrotów silników w zawisie.
+    double vibrationG = 0.12;       ///< Amplituda drgań pierwszej harmonicznej.
+    double biasG = 0.03;            ///< Odchylenie standardowe błędu zera każdej osi.
+    double noiseG = 0.01;           ///< Odchylenie standardowe szumu pomiaru.
+    double maneuverDeg = 12.0;      ///< Największe zadane przechylenie.
+    double maneuverSeconds = 4.0;   ///< Średni czas między zmianami manewru.
+    double gustMs = 1.5;            ///< Odchylenie standardowe prędkości wiatru.
+};
+
+/**
+ * @brief Uproszczony model bryły sztywnej drona i jego akcelerometru.
+ *
+ * Dron utrzymuje zadaną wysokość i wykonuje losowe manewry przechylenia, wiatr to
+ * proces Ornsteina-Uhlenbecka. Akcelerometr mierzy siłę właściwą w układzie drona
+ * (w zawisie +1 g na osi Z) z drganiami czterech silników (harmoniczne 1x i 2x
+ * częstotliwości obrotów zależnej od ciągu), stałym błędem zera i szumem.
+ * Wynik zależy wyłącznie od ziarna i kolejnych kroków dt – nie od zegara.
+ */
+class DroneModel
+{
+public:
+    explicit DroneModel(std::uint64_t seed = 1, const DroneParameters& parameters = DroneParameters());
+
+    // Powrót do stanu początkowego dla danego ziarna
+    void reset(std::uint64_t seed);
+    // Krok symulacji o dt sekund; wynik: siła właściwa w układzie drona [g]
+    void step(double dt, double& ax, double& ay, double& az);
+
+private:
+    DroneParameters p;
+    Xoshiro256 rng;
+    double roll = 0.0, pitch = 0.0, yaw = 0.0;           ///< Orientacja [rad].
+    double rollTarget = 0.0, pitchTarget = 0.0, yawRate = 0.0;
+    double velocity[3] = {0.0, 0.0, 0.0};                ///< Prędkość w układzie ziemi [m/s].
+    double altitude = 0.0, altitudeTarget = 10.0;
+    double wind[3] = {0.0, 0.0, 0.0};
+    double bias[3] = {0.0, 0.0, 0.0};
+    double motorPhase[4] = {0.0, 0.0, 0.0, 0.0};
+    double motorDetune[4] = {0.0, 0.0, 0.0, 0.0};         ///< Względna różnica obrotów silników.
+    double untilManeuver = 0.0;                          ///< Czas do zmiany manewru [s].
+};
+
+#endif // DRONEMODEL_HPP
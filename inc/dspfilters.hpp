@@ -0,0 +1,155 @@
+#ifndef DSPFILTERS_HPP
+#define DSPFILTERS_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Filtry cyfrowe dla bloków próbek trzech osi w układzie struktury tablic (SoA).
+ *
+ * Jądra obliczeniowe mają wersję skalarną oraz wektorową (AVX, SSE2), wybieraną
+ * w czasie kompilacji na podstawie dostępnego zestawu instrukcji. Filtry rekurencyjne
+ * (IIR) są wektoryzowane w poprzek osi X/Y/Z, a FIR – wzdłuż czasu. Średnia krocząca
+ * ma tylko wersję skalarną (hasSimdKernel()).
+ */
+namespace dsp {
+
+// Blok próbek: osobna ciągła tablica na każdą oś
+struct SoaBlock
+{
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+
+    void resize(std::size_t count)
+    {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+    }
+    std::size_t size() const { return x.size(); }
+};
+
+// Nazwa zestawu instrukcji, dla którego zostały skompilowane jądra wektorowe
+const char* simdInstructionSet();
+
+class Filter
+{
+public:
+    virtual ~Filter() = default;
+    virtual void process(SoaBlock& block) = 0;
+    virtual void reset() = 0;
+    virtual std::string name() const = 0;
+
+    // Wyłączenie jąder wektorowych – do porównań w benchmarkach
+    void setSimdEnabled(bool enabled) { m_simd = enabled; }
+    // Czy w tej kompilacji filtr ma jądro wektorowe (bez niego setSimdEnabled() nic nie zmienia)
+    virtual bool hasSimdKernel() const;
+
+protected:
+    bool m_simd = true;
+};
+
+/**
+ * @brief Filtr bikwadratowy IIR (dolno- lub górnoprzepustowy, wzory RBJ),
+ * struktura Direct Form II transposed.
+ */
+class Biquad : public Filter
+{
+public:
+    enum class Type { LowPass, HighPass };
+
+    Biquad(Type type, double sampleRate, double cutoffHz, double q = 0.7071067811865476);
+
+    void process(SoaBlock& block) override;
+    void reset() override;
+    std::string name() const override;
+
+private:
+    Type m_type;
+    double m_cutoff;
+    double m_b0, m_b1, m_b2, m_a1, m_a2;
+    alignas(32) double m_s1[4] = {0.0, 0.0, 0.0, 0.0}; ///< Stan filtru dla X, Y, Z (+ pas wyrównania).
+    alignas(32) double m_s2[4] = {0.0, 0.0, 0.0, 0.0};
+};
+
+/**
+ * @brief Średnia krocząca – suma bieżąca aktualizowana w O(1) na próbkę.
+ */
+class MovingAverage : public Filter
+{
+public:
+    explicit MovingAverage(std::size_t length);
+
+    void process(SoaBlock& block) override;
+    void reset() override;
+    std::string name() const override;
+    bool hasSimdKernel() const override { return false; }
+
+private:
+    std::size_t m_length;
+    std::vector<double> m_history[3];
+    double m_sum[3] = {0.0, 0.0, 0.0};
+    std::size_t m_pos = 0;
+    std::size_t m_filled = 0;
+};
+
+/**
+ * @brief Filtr FIR o współczynnikach podanych przez użytkownika.
+ */
+class Fir : public Filter
+{
+public:
+    explicit Fir(std::vector<double> taps);
+
+    void process(SoaBlock& block) override;
+    void reset() override;
+    std::string name() const override;
+
+private:
+    void processChannel(std::vector<double>& data, std::vector<double>& history);
+
+    std::vector<double> m_reversed;      ///< Współczynniki w odwróconej kolejności (ciągłe odczyty).
+    std::vector<double> m_history[3];    ///< Ostatnie taps-1 próbek każdej osi.
+    std::vector<double> m_scratch;       ///< Historia + bieżący blok.
+};
+
+/**
+ * @brief Usuwanie składowej grawitacyjnej: odjęcie estymaty z jednobiegunowego filtra
+ * dolnoprzepustowego o bardzo niskiej częstotliwości odcięcia.
+ */
+class GravityRemoval : public Filter
+{
+public:
+    GravityRemoval(double sampleRate, double cutoffHz = 0.3);
+
+    void process(SoaBlock& block) override;
+    void reset() override;
+    std::string name() const override;
+
+private:
+    double m_alpha;
+    bool m_initialized = false;
+    alignas(32) double m_gravity[4] = {0.0, 0.0, 0.0, 0.0};
+};
+
+// Łańcuch filtrów wykonywanych kolejno na tym samym bloku
+class FilterChain
+{
+public:
+    void add(std::unique_ptr<Filter> filter);
+    void process(SoaBlock& block);
+    void reset();
+    void setSimdEnabled(bool enabled);
+    bool empty() const { return m_filters.empty(); }
+    std::size_t size() const { return m_filters.size(); }
+
+private:
+    std::vector<std::unique_ptr<Filter>> m_filters;
+};
+
+} // namespace dsp
+
+#endif // DSPFILTERS_HPP
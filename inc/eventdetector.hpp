@@ -0,0 +1,115 @@
+#ifndef EVENTDETECTOR_HPP
+#define EVENTDETECTOR_HPP
+
+#include "accsample.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Wykrywanie zdarzeń (swobodny spadek, uderzenie, nadmierne drgania) na podstawie reguł progowych.
+ *
+ * Każdy strumień ma własny detektor (okna i stan reguł), wołany w wątku puli na surowych
+ * próbkach. Dla każdej próbki liczone są wielkości chwilowe (moduł przyspieszenia, zryw)
+ * i agregaty w oknach czasowych – średnia, RMS, maksimum, minimum – aktualizowane w O(1)
+ * (zamortyzowanym) na próbkę: sumy bieżące i kolejki monotoniczne. Reguły korzystające
+ * z tej samej wielkości i długości okna dzielą jedno okno, więc koszt reguły to jedno
+ * porównanie.
+ *
+ * Reguła ma próg zgłoszenia i osobny próg odwołania (histereza) oraz czas, przez który
+ * warunek musi być spełniony bez przerwy, zanim zdarzenie zostanie zgłoszone.
+ * Plik nie zależy od Qt – korzysta z niego też benchmark.
+ */
+class EventDetector
+{
+public:
+    enum class Quantity {
+        Magnitude,  ///< Moduł przyspieszenia |a| [g].
+        Jerk        ///< Zryw |a(t) - a(t-1)| / dt [g/s].
+    };
+
+    enum class Aggregate {
+        Instant,    ///< Wartość bieżącej próbki (bez okna).
+        Mean,       ///< Średnia w oknie.
+        Rms,        ///< RMS odchyleń od średniej w oknie; dla Magnitude – wektora a, czyli drgania niezależne od grawitacji i orientacji.
+        Peak,       ///< Maksimum w oknie.
+        Min         ///< Minimum w oknie.
+    };
+
+    enum class Compare { Above, Below };
+
+    struct Rule
+    {
+        std::string name;
+        Quantity quantity = Quantity::Magnitude;
+        Aggregate aggregate = Aggregate::Instant;
+        std::int64_t windowNs = 0;   ///< Długość okna agregatu [ns]; pomijana dla Instant.
+        Compare compare = Compare::Above;
+        double threshold = 0.0;      ///< Próg zgłoszenia.
+        double release = 0.0;        ///< Próg odwołania (dla Above nie większy niż threshold, dla Below nie mniejszy).
+        std::int64_t holdNs = 0;     ///< Czas nieprzerwanego spełnienia warunku przed zgłoszeniem [ns].
+    };
+
+    using RuleSet = std::vector<Rule>;
+
+    struct Event
+    {
+        enum class Kind { Raised, Cleared };
+
+        Kind kind = Kind::Raised;
+        int rule = 0;                ///< Indeks reguły w zestawie.
+        std::string name;            ///< Nazwa reguły.
+        double value = 0.0;          ///< Wartość wielkości w chwili zgłoszenia lub odwołania.
+        double peak = 0.0;           ///< Skrajna wartość od zgłoszenia (dla Cleared).
+        std::int64_t onset = 0;      ///< Pierwsza próbka spełniająca warunek [ns].
+        std::int64_t timestamp = 0;  ///< Próbka, na której zdarzenie zostało rozpoznane [ns].
+    };
+
+    // Reguły domyślne: swobodny spadek, uderzenie, nadmierne drgania
+    static RuleSet defaultRules();
+
+    EventDetector();
+    ~EventDetector();
+    EventDetector(const EventDetector&) = delete;
+    EventDetector& operator=(const EventDetector&) = delete;
+
+    // Podmiana reguł; bezpieczna z dowolnego wątku, przejmowana w następnym process().
+    // nullptr lub pusty zestaw wyłącza wykrywanie. Stan okien i reguł jest zerowany.
+    void setRules(std::shared_ptr<const RuleSet> rules);
+
+    // Ocena bloku próbek; rozpoznane zdarzenia są dopisywane do events.
+    // Wywołania process() muszą być szeregowane przez właściciela detektora.
+    void process(const AccSample* samples, std::size_t count, std::vector<Event>& events);
+    bool isEnabled() const { return !m_ruleStates.empty(); }
+
+private:
+    struct Window;
+    struct RuleState
+    {
+        int window = -1;             ///< Indeks okna; -1 – wielkość chwilowa.
+        bool active = false;
+        bool pending = false;
+        std::int64_t onset = 0;
+        double peak = 0.0;
+    };
+
+    void configure();
+
+    std::mutex m_pendingMutex;
+    std::shared_ptr<const RuleSet> m_pending;    ///< Reguły czekające na przejęcie w process().
+    std::atomic<bool> m_hasPending{false};
+
+    // Stan używany wyłącznie w process()
+    std::shared_ptr<const RuleSet> m_rules;
+    std::vector<Window> m_windows;
+    std::vector<RuleState> m_ruleStates;
+    AccSample m_previous{};
+    bool m_hasPrevious = false;
+    bool m_needsJerk = false;
+};
+
+#endif // EVENTDETECTOR_HPP
@@ -0,0 +1,40 @@
+#ifndef EXTERNALSOURCE_HPP
+#define EXTERNALSOURCE_HPP
+
+#include "samplesource.hpp"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief Źródło dla danych dostarczanych z zewnątrz (np. z portu szeregowego przez push()).
+ *
+ * Zastępuje symulator strumienia 0 tak jak ReplaySource, więc w jednym strumieniu nigdy
+ * nie mieszają się próbki z dwóch zegarów. poll() oddaje wszystko, co wstawiono od
+ * poprzedniego taktu; przy zatorze nadmiarowe bloki są odrzucane i liczone.
+ */
+class ExternalSource : public SampleSource
+{
+    Q_OBJECT
+
+public:
+    explicit ExternalSource(QObject *parent = nullptr);
+
+    void start() override;
+    void stop() override;
+    bool isRunning() const override;
+    AccSampleBlock poll(std::int64_t now) override;
+
+    // Wstawienie bloku; bezpieczne z dowolnego wątku. Po stop() bloki są pomijane.
+    void push(const AccSampleBlock& block);
+    quint64 droppedSamples() const;
+
+private:
+    std::mutex mutex;
+    AccSampleBlock pending;                 ///< Próbki czekające na takt (chronione mutex).
+    std::atomic<bool> running{false};
+    std::atomic<quint64> dropped{0};
+
+    static constexpr qsizetype MaxPendingSamples = 1 << 20;
+};
+
+#endif // EXTERNALSOURCE_HPP
@@ -0,0 +1,35 @@
+#ifndef FILTERSTAGE_HPP
+#define FILTERSTAGE_HPP
+
+#include "accsampleblock.hpp"
+#include "dspfilters.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Etap przetwarzania bloków próbek łańcuchem filtrów dsp::FilterChain.
+ *
+ * Każdy strumień SimulationController ma własny etap (filtry mają stan), wołany
+ * w wątku puli tuż za źródłem danych. Blok jest przepisywany do układu SoA,
+ * filtrowany i składany z powrotem w nowy blok. Bez skonfigurowanych filtrów
+ * blok przechodzi dalej bez kopiowania.
+ */
+class FilterStage
+{
+public:
+    // Podmiana łańcucha filtrów; bezpieczna z dowolnego wątku. nullptr wyłącza filtrowanie.
+    void setChain(std::shared_ptr<dsp::FilterChain> chain);
+
+    // Wywołania process() muszą być szeregowane przez właściciela etapu
+    AccSampleBlock process(const AccSampleBlock& block);
+
+private:
+    std::mutex m_pendingMutex;
+    std::shared_ptr<dsp::FilterChain> m_pending; ///< Łańcuch czekający na przejęcie w process().
+    std::atomic<bool> m_hasPending{false};
+    std::shared_ptr<dsp::FilterChain> m_chain;   ///< Używany wyłącznie w process().
+    dsp::SoaBlock m_soa;                         ///< Bufor roboczy wielokrotnego użytku.
+};
+
+#endif // FILTERSTAGE_HPP
@@ -0,0 +1,76 @@
+#ifndef FLIGHTRECORDER_HPP
+#define FLIGHTRECORDER_HPP
+
+#include "accsampleblock.hpp"
+#include "flightrecordformat.hpp"
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <vector>
+
+class QThread;
+
+/**
+ * @brief Rejestrator lotu zapisujący próbki do binarnego pliku *.accrec.
+ *
+ * record() tylko odkłada blok (współdzielony, bez kopiowania danych) do kolejki –
+ * zapisem na dysk zajmuje się osobny wątek, więc wątek GUI nigdy nie czeka na I/O.
+ * Gdy dysk nie nadąża i kolejka przekroczy limit, kolejne bloki są odrzucane i liczone.
+ */
+class FlightRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FlightRecorder(QObject *parent = nullptr);
+    ~FlightRecorder();
+
+    bool start(const QString& path);
+    // Dopisanie zaległych danych, indeksu i zamknięcie pliku
+    void stop();
+    bool isRecording() const;
+
+    QString errorString() const;
+    quint64 recordedSamples() const;
+    quint64 droppedSamples() const;
+
+public slots:
+    void record(const AccSampleBlock& block);
+
+signals:
+    // Błąd zapisu (np. brak miejsca na dysku) – wątek zapisu skończył pracę, należy wywołać stop()
+    void writeFailed(const QString& message);
+
+private:
+    void writerLoop();
+    void append(const AccSampleBlock& block);
+    void writeChunk();
+    void writeIndex();
+    bool writeAll(const void* data, qint64 size);
+
+    QThread* writerThread = nullptr;
+    mutable QMutex mutex;
+    QWaitCondition wake;
+    QVector<AccSampleBlock> pending;    ///< Bloki czekające na zapis (chronione mutex).
+    qsizetype pendingSamples = 0;
+    bool stopRequested = false;
+
+    // Stan używany wyłącznie przez wątek zapisu
+    QFile file;
+    std::vector<AccSample> chunk;
+    QVector<FlightRecordFormat::IndexEntry> index;
+
+    QString error;                      ///< Chronione mutex (ustawiane też przez wątek zapisu).
+    std::atomic<bool> failed{false};    ///< Zapis przerwany błędem – kolejne bloki są odrzucane.
+    std::atomic<quint64> written{0};
+    std::atomic<quint64> dropped{0};
+
+    static constexpr int ChunkSamples = 4096;              ///< Próbek w pełnej porcji.
+    static constexpr int FlushIntervalMs = 1000;           ///< Niepełna porcja trafia na dysk najpóźniej po tym czasie.
+    static constexpr qsizetype MaxPendingSamples = 1 << 20;
+};
+
+#endif // FLIGHTRECORDER_HPP
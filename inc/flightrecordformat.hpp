@@ -0,0 +1,60 @@
+#ifndef FLIGHTRECORDFORMAT_HPP
+#define FLIGHTRECORDFORMAT_HPP
+
+#include "accsample.hpp"
+#include <cstdint>
+
+/**
+ * @brief Układ pliku nagrania lotu (*.accrec).
+ *
+ * Plik jest dopisywany wyłącznie na końcu:
+ *  - FileHeader,
+ *  - dowolna liczba porcji: ChunkHeader + count * AccSample,
+ *  - przy poprawnym zamknięciu: tablica IndexEntry (po jednym wpisie na porcję) i IndexTrailer.
+ *
+ * Gdy nagranie zostało przerwane (brak stopki), indeks odtwarza się, przechodząc po
+ * nagłówkach porcji. Wszystkie struktury mają naturalne wyrównanie, dzięki czemu
+ * próbki można czytać bezpośrednio z pliku odwzorowanego w pamięci.
+ */
+namespace FlightRecordFormat {
+
+constexpr char FileMagic[8] = {'A', 'C', 'C', 'R', 'E', 'C', '0', '1'};
+constexpr std::uint32_t Version = 1;
+constexpr std::uint32_t ChunkMagic = 0x4B4E4843; // "CHNK"
+constexpr std::uint32_t IndexMagic = 0x58444941; // "AIDX"
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t sampleSize; ///< sizeof(AccSample) w momencie zapisu.
+};
+
+struct ChunkHeader
+{
+    std::uint32_t magic;
+    std::uint32_t count;
+    std::int64_t firstTimestamp;
+    std::int64_t lastTimestamp;
+};
+
+struct IndexEntry
+{
+    std::int64_t firstTimestamp;
+    std::uint64_t offset; ///< Położenie ChunkHeader w pliku.
+};
+
+struct IndexTrailer
+{
+    std::uint64_t indexOffset;
+    std::uint32_t entryCount;
+    std::uint32_t magic;
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "FileHeader musi zachować wyrównanie próbek");
+static_assert(sizeof(ChunkHeader) % 8 == 0, "ChunkHeader musi zachować wyrównanie próbek");
+static_assert(sizeof(AccSample) == 32, "Zmiana AccSample zmienia format pliku");
+
+} // namespace FlightRecordFormat
+
+#endif // FLIGHTRECORDFORMAT_HPP
@@ -0,0 +1,82 @@
+#ifndef INTERVALTRACKER_HPP
+#define INTERVALTRACKER_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Śledzenie odstępów między kolejnymi znacznikami czasu jednego strumienia.
+ *
+ * Nominalny odstęp jest średnią wykładniczą odstępów uznanych za poprawne, więc
+ * tracker nie musi znać częstotliwości źródła (symulator, port, nagranie). Odstęp
+ * dłuższy niż GapFactor nominalnych (i co najmniej MinGapNs) jest przerwą – próbki
+ * spóźnione albo brakujące – i nie zmienia średniej. Jeśli jednak RelearnGaps przerw
+ * z rzędu ma podobną długość (w granicach 1/4), źródło po prostu zwolniło: tracker
+ * przyjmuje ich długość jako nowy odstęp nominalny i kolejne próbki nie są już przerwami.
+ */
+class IntervalTracker
+{
+public:
+    static constexpr std::int64_t GapFactor = 3;
+    static constexpr std::int64_t MinGapNs = 20'000'000; ///< Dwa takty harmonogramu.
+    static constexpr int RelearnGaps = 4;                ///< Podobne przerwy z rzędu, po których zmienia się odstęp.
+
+    struct Step
+    {
+        std::int64_t deviationNs = 0; ///< |odstęp - nominalny|; 0 dla pierwszej próbki i przerw.
+        std::int64_t gapNs = 0;       ///< Długość przerwy przed próbką; 0, gdy jej nie było.
+    };
+
+    Step observe(std::int64_t timestamp)
+    {
+        Step step;
+        if (m_last != 0 && timestamp > m_last) {
+            const std::int64_t delta = timestamp - m_last;
+            if (m_interval == 0) {
+                m_interval = delta;
+            } else if (delta > GapFactor * m_interval && delta > MinGapNs) {
+                const std::int64_t diff = delta > m_gapInterval ? delta - m_gapInterval : m_gapInterval - delta;
+                if (m_gapRun > 0 && diff <= m_gapInterval / 4) {
+                    ++m_gapRun;
+                } else {
+                    m_gapRun = 1;
+                    m_gapInterval = delta;
+                }
+                if (m_gapRun >= RelearnGaps) {
+                    // Nowa częstotliwość źródła, a nie przerwa – próbka wyznacza nowy odstęp
+                    m_interval = delta;
+                    m_gapRun = 0;
+                } else {
+                    step.gapNs = delta;
+                }
+            } else {
+                m_gapRun = 0;
+                step.deviationNs = delta > m_interval ? delta - m_interval : m_interval - delta;
+                m_interval += (delta - m_interval) / 16;
+                if (m_interval == 0)
+                    m_interval = 1;
+            }
+        }
+        m_last = timestamp;
+        return step;
+    }
+
+    // Nominalny odstęp [ns]; 0 – jeszcze nieznany
+    std::int64_t interval() const { return m_interval; }
+    std::int64_t lastTimestamp() const { return m_last; }
+
+    void reset()
+    {
+        m_last = 0;
+        m_interval = 0;
+        m_gapRun = 0;
+        m_gapInterval = 0;
+    }
+
+private:
+    std::int64_t m_last = 0;
+    std::int64_t m_interval = 0;
+    int m_gapRun = 0;                  ///< Podobne przerwy z rzędu.
+    std::int64_t m_gapInterval = 0;    ///< Długość pierwszej z nich.
+};
+
+#endif // INTERVALTRACKER_HPP
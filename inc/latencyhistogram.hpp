@@ -0,0 +1,131 @@
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Histogram opóźnień w stylu HDR: kubełki logarytmiczno-liniowe.
+ *
+ * Każdy przedział [2^k, 2^(k+1)) jest podzielony na 8 równych kubełków, więc błąd
+ * względny odczytu percentyla nie przekracza 12,5%. Zakres: do 2^40 ns (ok. 18 min).
+ * record() wykonuje wyłącznie zwykły zapis – histogram ma jednego pisarza
+ * (wątek będący jego właścicielem), a czytelnicy sumują kopie przez merge().
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int SubBucketBits = 3;
+    static constexpr int SubBuckets = 1 << SubBucketBits;
+    static constexpr int MaxBits = 40;
+    static constexpr int BucketCount = SubBuckets + (MaxBits - SubBucketBits) * SubBuckets;
+
+    static int bucketFor(std::uint64_t value)
+    {
+        value = std::min<std::uint64_t>(value, (std::uint64_t(1) << MaxBits) - 1);
+        if (value < SubBuckets)
+            return static_cast<int>(value);
+        int msb = 63;
+        while (!(value >> msb))
+            --msb;
+        const int shift = msb - SubBucketBits;
+        return SubBuckets + shift * SubBuckets + static_cast<int>((value >> shift) - SubBuckets);
+    }
+
+    // Dolna granica wartości w kubełku
+    static std::uint64_t bucketLowerBound(int index)
+    {
+        if (index < SubBuckets)
+            return static_cast<std::uint64_t>(index);
+        const int shift = (index - SubBuckets) / SubBuckets;
+        const int sub = (index - SubBuckets) % SubBuckets;
+        return static_cast<std::uint64_t>(SubBuckets + sub) << shift;
+    }
+
+    // Wartość reprezentatywna kubełka (środek przedziału)
+    static std::uint64_t bucketValue(int index)
+    {
+        if (index < SubBuckets)
+            return static_cast<std::uint64_t>(index);
+        const int shift = (index - SubBuckets) / SubBuckets;
+        return bucketLowerBound(index) + ((std::uint64_t(1) << shift) >> 1);
+    }
+
+    // Zapis z wątku właściciela – bez operacji atomowych typu read-modify-write
+    void record(std::uint64_t value)
+    {
+        std::atomic<std::uint64_t>& bucket = m_counts[bucketFor(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value > m_max.load(std::memory_order_relaxed))
+            m_max.store(value, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count(int index) const { return m_counts[index].load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<std::uint64_t>, BucketCount> m_counts{};
+    std::atomic<std::uint64_t> m_max{0};
+};
+
+/**
+ * @brief Zwykła (nieatomowa) kopia histogramu – wynik sumowania kilku wątków.
+ */
+struct HistogramSnapshot
+{
+    std::array<std::uint64_t, LatencyHistogram::BucketCount> counts{};
+    std::uint64_t total = 0;
+    std::uint64_t max = 0;
+
+    void merge(const LatencyHistogram& histogram)
+    {
+        for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+            const std::uint64_t count = histogram.count(i);
+            counts[i] += count;
+            total += count;
+        }
+        max = std::max(max, histogram.max());
+    }
+
+    // Histogram przyrostów od wcześniejszej migawki tych samych liczników, czyli okno między migawkami.
+    // Maksimum okna jest dokładne, jeśli padło w tym oknie; w przeciwnym razie przybliża je górna
+    // granica najwyższego niepustego kubełka.
+    HistogramSnapshot since(const HistogramSnapshot& earlier) const
+    {
+        HistogramSnapshot window;
+        int top = -1;
+        for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+            const std::uint64_t count = counts[i] > earlier.counts[i] ? counts[i] - earlier.counts[i] : 0;
+            window.counts[i] = count;
+            window.total += count;
+            if (count > 0)
+                top = i;
+        }
+        if (max > earlier.max)
+            window.max = max;
+        else if (top >= 0)
+            window.max = top + 1 < LatencyHistogram::BucketCount
+                ? std::min(LatencyHistogram::bucketLowerBound(top + 1) - 1, max)
+                : max;
+        return window;
+    }
+
+    // Percentyl p z zakresu [0, 1]
+    std::uint64_t percentile(double p) const
+    {
+        if (total == 0)
+            return 0;
+        const std::uint64_t rank = static_cast<std::uint64_t>(p * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (int i = 0; i < LatencyHistogram::BucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(LatencyHistogram::bucketValue(i), max);
+        }
+        return max;
+    }
+};
+
+#endif // LATENCYHISTOGRAM_HPP
@@ -2,16 +2,24 @@
 #define MAINWINDOW_HPP
 #include "simulationcontroller.hpp"
 #include "SpinBoxController.hpp"
-#include "chartwindow.hpp"
+#include "spectrumwindow.hpp"
+#include "statspanel.hpp"
 #include "translate.hpp"
+#include "serialreader.hpp"
+#include "flightrecorder.hpp"
+#include "sessionexporter.hpp"
 #include <QMainWindow>
 #include <QSerialPort>
+#include <vector>
 QT_BEGIN_NAMESPACE
 namespace Ui {
 class MainWindow;
 }
 QT_END_NAMESPACE
 
+// Okno wykresów (QtCharts) jest tworzone dopiero po starcie – nagłówek dołącza tylko mainwindow.cpp
+class ChartWindow;
+
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -22,13 +30,37 @@ public:
 
 private slots:
     void on_pushButtonCharts_clicked();
+    void on_pushButtonSpectrum_clicked();
+    void on_pushButtonStats_clicked();
     void on_pushButtonLanguage_clicked();
     void on_pushButtonStart_clicked();
+    void on_pushButtonConnect_clicked();
+    void on_pushButtonRecord_clicked();
+    void on_pushButtonReplay_clicked();
+    void on_pushButtonExport_clicked();
+    void drainSerial();
+    void applyFilterPreset(int index);
+    void showDetectorEvent(int streamId, const EventDetector::Event& event);
+    void prewarmCharts();
+    void prewarmStep();
 private:
+    std::shared_ptr<dsp::FilterChain> buildFilterChain(int index) const;
+    void createChartWindow(bool deferred);
+
     SpinBoxController* spinController;
     ChartWindow* chartWindow = nullptr;
+    SpectrumWindow* spectrumWindow = nullptr;
+    StatsPanel* statsPanel = nullptr;
     Translator* translator = nullptr;
     Ui::MainWindow *ui;
     SimulationController* simulationController;
+    SerialReader* serialReader;
+    FlightRecorder* recorder;
+    SessionExporter* exporter;
+    bool replaying = false;
+    std::int64_t prewarmStarted = 0;      ///< Początek budowy okna wykresów w tle [ns].
+    std::int64_t prewarmLongestStep = 0;  ///< Najdłuższy krok budowy – najdłuższa blokada pętli zdarzeń [ns].
+    int prewarmSteps = 0;
+    std::vector<AccSample> serialBuffer; ///< Bufor wielokrotnego użytku dla próbek z portu szeregowego.
 };
 #endif // MAINWINDOW_HPP
@@ -0,0 +1,60 @@
+#ifndef MINMAXPYRAMID_HPP
+#define MINMAXPYRAMID_HPP
+
+#include "circularbuffer.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Wielorozdzielcza historia jednego kanału: piramida kubełków min/max.
+ *
+ * Poziom 0 przechowuje surowe próbki, każdy kolejny poziom agreguje @c fanout
+ * kubełków poziomu niższego. Piramida jest budowana przyrostowo (O(1) zamortyzowane
+ * na próbkę), a każdy poziom ma stałą pojemność wynikającą z budżetu pamięci –
+ * najstarsze dane znikają najpierw z poziomów najdrobniejszych.
+ *
+ * Zapytanie o przedział czasu wybiera najdrobniejszy poziom, który mieści się
+ * w zadanej liczbie kubełków (np. szerokości wykresu w pikselach), więc koszt
+ * rysowania zależy od liczby pikseli, a nie od liczby próbek.
+ */
+class MinMaxPyramid
+{
+public:
+    struct Bucket
+    {
+        double t0;  ///< Czas pierwszej próbki w kubełku [s].
+        double t1;  ///< Czas ostatniej próbki w kubełku [s].
+        double min;
+        double max;
+    };
+
+    explicit MinMaxPyramid(std::size_t budgetBytes = 8 * 1024 * 1024,
+                           std::size_t levels = 10,
+                           std::size_t fanout = 4);
+
+    void append(double time, double value);
+    void clear();
+
+    // Kubełki z przedziału [t0, t1], najwyżej ok. maxBuckets sztuk, posortowane po czasie
+    void query(double t0, double t1, std::size_t maxBuckets, std::vector<Bucket>& out) const;
+
+    // Czas najstarszej zachowanej próbki (na dowolnym poziomie)
+    double oldestTime() const;
+    double newestTime() const;
+    bool empty() const { return m_levels[0].empty(); }
+
+    std::size_t levelCount() const { return m_levels.size(); }
+    std::size_t memoryBytes() const;
+
+private:
+    void push(std::size_t level, const Bucket& bucket);
+    // Indeks pierwszego kubełka poziomu, którego t1 >= time
+    std::size_t lowerBound(const CircularBuffer<Bucket>& level, double time) const;
+
+    std::size_t m_fanout;
+    std::vector<CircularBuffer<Bucket>> m_levels;
+    std::vector<Bucket> m_pending;        ///< Kubełek w trakcie składania dla poziomu k+1.
+    std::vector<std::size_t> m_pendingCount;
+};
+
+#endif // MINMAXPYRAMID_HPP
@@ -0,0 +1,95 @@
+#ifndef PIPELINESTATS_HPP
+#define PIPELINESTATS_HPP
+
+#include "accsample.hpp"
+#include "latencyhistogram.hpp"
+#include <QJsonObject>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lekka instrumentacja toru danych: liczniki i histogramy opóźnień per etap.
+ *
+ * Każdy wątek zapisuje do własnego zestawu liczników (shard), więc na gorącej ścieżce
+ * nie ma blokad ani współdzielonych linii pamięci podręcznej. snapshot() sumuje
+ * wszystkie wątki – jest przeznaczony dla panelu statystyk i zrzutu JSON.
+ */
+namespace PipelineStats {
+
+enum class Stage {
+    Tick,         ///< Takt harmonogramu: spóźnienie wybudzenia względem terminu (pominięte takty – coalesced).
+    Source,       ///< Generowanie lub odczyt próbek (symulator, port, nagranie).
+    Interval,     ///< Odchylenie odstępu między próbkami od nominalnego (próbki w przerwach – dropped).
+    Filter,       ///< Etap filtracji w wątku roboczym.
+    Detect,       ///< Detektor zdarzeń: opóźnienie od próbki rozpoznającej zdarzenie do odebrania w GUI (próbki – ocenione).
+    Dispatch,     ///< Kolejka zdarzeń wątek roboczy -> GUI (opóźnienie od wygenerowania próbki).
+    SpinBox,      ///< Aktualizacja wyświetlaczy.
+    ChartAdd,     ///< ChartWindow: dopisanie bloku do historii.
+    ChartRefresh, ///< ChartWindow: przygotowanie punktów i replace().
+    ChartPaint,   ///< Wiek najnowszej próbki w chwili rysowania wykresu.
+    Count
+};
+
+constexpr int StageCount = static_cast<int>(Stage::Count);
+
+const char* stageName(Stage stage);
+
+// Zapis opóźnienia [ns] i liczby przetworzonych próbek
+void record(Stage stage, std::int64_t latencyNs, std::int64_t samples = 0);
+void addSamples(Stage stage, std::int64_t samples);
+void addDropped(Stage stage, std::int64_t samples);
+// Zdarzenia połączone z innymi (np. próbki, których wyświetlacz nie pokazał, pominięte klatki)
+void addCoalesced(Stage stage, std::int64_t count);
+
+// Głębokość kolejki między wątkami (w blokach)
+void queueEnter(Stage stage);
+void queueLeave(Stage stage);
+
+struct StageSnapshot
+{
+    std::uint64_t events = 0;
+    std::uint64_t samples = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t coalesced = 0;
+    std::int64_t queueDepth = 0;
+    std::int64_t maxQueueDepth = 0;
+    HistogramSnapshot latency;
+};
+
+struct Snapshot
+{
+    std::int64_t timestamp = 0; ///< Chwila wykonania migawki (accTimestampNow()).
+    std::array<StageSnapshot, StageCount> stages;
+};
+
+Snapshot snapshot();
+
+// Migawka w postaci JSON: latencyTotal – opóźnienia od startu; jeśli podano previous, dodawane są
+// częstotliwości zdarzeń i próbek oraz latencyInterval – opóźnienia od migawki previous
+QJsonObject toJson(const Snapshot& current, const Snapshot* previous = nullptr);
+
+/**
+ * @brief Pomiar czasu trwania zakresu (RAII) zapisywany do danego etapu.
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(Stage stage, std::int64_t samples = 0)
+        : m_stage(stage), m_samples(samples), m_start(accTimestampNow())
+    {
+    }
+    ~ScopedTimer() { record(m_stage, accTimestampNow() - m_start, m_samples); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Stage m_stage;
+    std::int64_t m_samples;
+    std::int64_t m_start;
+};
+
+} // namespace PipelineStats
+
+#endif // PIPELINESTATS_HPP
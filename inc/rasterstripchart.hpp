@@ -0,0 +1,84 @@
+#ifndef RASTERSTRIPCHART_HPP
+#define RASTERSTRIPCHART_HPP
+
+#include "minmaxpyramid.hpp"
+#include <QImage>
+#include <QPolygonF>
+#include <QWidget>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lekki wykres przewijany dla trzech osi, rysowany do trwałego obrazu.
+ *
+ * Jedna kolumna pikseli odpowiada stałemu odcinkowi czasu. Próbki są zbierane
+ * do kolumny (min/max każdej osi), a flush() rasteryzuje tylko kolumny zakończone
+ * od poprzedniego taktu. Obraz jest zapisywany cyklicznie, tak jak spektrogram
+ * w SpectrumView – przewijanie to dwa blity w paintEvent(), bez przesuwania pamięci.
+ * Bez antyaliasingu i bez sceny graficznej, więc dobrze znosi renderowanie programowe.
+ * Przerwy w danych są zaznaczane pasem tła, a łamane nie są przez nie przeciągane.
+ */
+class RasterStripChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit RasterStripChart(QWidget *parent = nullptr);
+
+    void setTitle(const QString &title);
+    // Długość widocznego okna [s]; 0 – okno wyznaczają wywołania rebuild()
+    void setTimeWindow(double seconds);
+    void setValueRange(double min, double max);
+    int columnCount() const { return image.width(); }
+
+    // Dopisanie próbki; czas musi rosnąć. afterGap – próbka kończy przerwę w danych.
+    // Widoczne po najbliższym flush().
+    void append(double time, double x, double y, double z, bool afterGap = false);
+    // Rasteryzacja kolumn zakończonych od ostatniego wywołania i zlecenie przerysowania
+    void flush();
+    // Pełne przerysowanie z historii: kubełki trzech osi z przedziału [t0, t1] i przerwy (początek, koniec) [s]
+    void rebuild(double t0, double t1, const std::vector<MinMaxPyramid::Bucket> axes[3],
+                 const std::vector<std::pair<double, double>> &gaps = {});
+
+signals:
+    // Obraz został wyczyszczony (np. zmiana rozmiaru) – właściciel powinien wywołać rebuild()
+    void rebuildRequested();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    struct Column
+    {
+        float min[3];
+        float max[3];
+        bool valid = false;
+        bool gap = false;           ///< Kolumna w całości w przerwie danych.
+        bool breakBefore = false;   ///< Łamana nie łączy tej kolumny z poprzednią.
+    };
+
+    void merge(Column &column, int axis, double min, double max) const;
+    void rasterize(const Column *columns, int count);
+    void clearImage();
+    double toY(double value) const;
+
+    QImage image;
+    QString title;
+    std::vector<Column> pending;    ///< Kolumny zakończone, czekające na rasteryzację.
+    Column current;                 ///< Kolumna, do której trafiają bieżące próbki.
+    qint64 currentIndex = 0;        ///< Numer bieżącej kolumny (czas / columnSeconds); może być ujemny.
+    bool hasCurrent = false;        ///< currentIndex jest ważny – od pierwszej próbki lub rebuild().
+    double windowSeconds = 15.0;
+    double columnSeconds = 0.0;
+    double valueMin = -2.0;
+    double valueMax = 2.0;
+    int writeX = 0;                 ///< Kolumna obrazu, do której trafi następna zakończona kolumna.
+    QPolygonF polyline;             ///< Bufor punktów łamanej, alokowany przy zmianie szerokości.
+    QPointF lastPoint[3];           ///< Ostatni punkt każdej osi – łączenie z kolejnym taktem.
+    bool hasLastPoint = false;
+    static const QRgb background;
+    static const QRgb gapBackground;
+};
+
+#endif // RASTERSTRIPCHART_HPP
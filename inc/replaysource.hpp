@@ -0,0 +1,88 @@
+#ifndef REPLAYSOURCE_HPP
+#define REPLAYSOURCE_HPP
+
+#include "flightrecordformat.hpp"
+#include "samplesource.hpp"
+#include <QFile>
+#include <QVector>
+#include <atomic>
+#include <limits>
+
+/**
+ * @brief Źródło danych odtwarzające nagranie *.accrec odwzorowane w pamięci.
+ *
+ * Zastępuje AccSimulator w SimulationController. Odtwarza w czasie rzeczywistym,
+ * N razy szybciej albo tak szybko, jak to możliwe (speed == 0). Przewijanie do
+ * dowolnego znacznika czasu to wyszukiwanie binarne po indeksie porcji, a potem
+ * wewnątrz porcji – O(log n). seek() i first/lastTimestamp() używają czasu nagrania,
+ * a próbki z poll() mają znaczniki przeliczone na bieżący zegar accTimestampNow().
+ */
+class ReplaySource : public SampleSource
+{
+    Q_OBJECT
+
+public:
+    explicit ReplaySource(QObject *parent = nullptr);
+    ~ReplaySource();
+
+    // Otwarcie i odwzorowanie pliku; wołać przed przekazaniem źródła do kontrolera
+    bool open(const QString& path);
+    QString errorString() const;
+
+    void start() override;
+    void stop() override;
+    bool isRunning() const override;
+    AccSampleBlock poll(std::int64_t now) override;
+
+    // Mnożnik prędkości: 1.0 – czas rzeczywisty, 0 – najszybciej, jak się da
+    void setSpeed(double factor);
+    // Przewinięcie do pierwszej próbki o znaczniku >= timestamp [ns]
+    void seek(qint64 timestamp);
+
+    qint64 firstTimestamp() const;
+    qint64 lastTimestamp() const;
+    qint64 sampleCount() const;
+
+private:
+    struct Chunk
+    {
+        qint64 firstTimestamp;
+        qint64 lastTimestamp;
+        const AccSample* samples; ///< Wskaźnik do danych w odwzorowanym pliku.
+        quint32 count;
+    };
+
+    bool loadIndex(qint64 dataEnd);
+    void scanChunks(qint64 dataEnd);
+    bool readChunk(quint64 offset, qint64 dataEnd, Chunk& out) const;
+    void seekTo(qint64 timestamp);
+    void restartClock(std::int64_t now);
+
+    QFile file;
+    uchar* mapped = nullptr;
+    qint64 mappedSize = 0;
+    QVector<Chunk> chunks;
+    qint64 totalSamples = 0;
+    QString error;
+
+    // Żądania z dowolnego wątku, przejmowane przy najbliższym poll()
+    static constexpr qint64 NoSeek = std::numeric_limits<qint64>::min();
+    std::atomic<bool> running{false};
+    std::atomic<bool> startRequested{false};
+    std::atomic<bool> clockRestart{false};
+    std::atomic<qint64> pendingSeek{NoSeek};
+    std::atomic<double> speed{1.0};
+
+    // Stan odtwarzania – używany wyłącznie w poll()
+    int chunkPos = 0;             ///< Bieżąca porcja.
+    quint32 samplePos = 0;        ///< Bieżąca próbka w porcji.
+    std::int64_t wallStart = 0;   ///< Chwila (zegar monotoniczny) rozpoczęcia odtwarzania od replayStart.
+    std::int64_t outputStart = 0; ///< Znacznik wyjściowy (bieżący zegar) próbki replayStart.
+    std::int64_t lastOutput = 0;  ///< Ostatni wysłany znacznik – wyjście jest ściśle rosnące.
+    qint64 replayStart = 0;       ///< Znacznik czasu nagrania odpowiadający wallStart.
+
+    static constexpr int MaxBlockSamples = 4096;
+    static constexpr int FastBlockSamples = 65536; ///< Limit bloku w trybie "najszybciej, jak się da".
+};
+
+#endif // REPLAYSOURCE_HPP
@@ -0,0 +1,35 @@
+#ifndef SAMPLESOURCE_HPP
+#define SAMPLESOURCE_HPP
+
+#include "accsampleblock.hpp"
+#include <QObject>
+
+/**
+ * @brief Wspólny interfejs źródeł próbek obsługiwanych przez SimulationController.
+ *
+ * Źródło nie ma własnego wątku ani timera: harmonogram kontrolera co takt zleca
+ * puli wątków wywołanie poll(), które oddaje próbki zaległe na daną chwilę.
+ * Dla jednego źródła poll() nigdy nie jest wołane współbieżnie, ale kolejne
+ * wywołania mogą trafić do różnych wątków puli. start()/stop() mogą być wołane
+ * z dowolnego wątku.
+ */
+class SampleSource : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SampleSource(QObject *parent = nullptr) : QObject(parent) {}
+
+    virtual void start() = 0;
+    virtual void stop() = 0;
+    virtual bool isRunning() const = 0;
+
+    // Próbki należne do chwili now [ns, zegar accTimestampNow()]; pusty blok, gdy brak nowych
+    virtual AccSampleBlock poll(std::int64_t now) = 0;
+
+signals:
+    // Źródło skończone (np. odtwarzanie pliku) doszło do końca danych
+    void finished();
+};
+
+#endif // SAMPLESOURCE_HPP
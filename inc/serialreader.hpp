@@ -0,0 +1,114 @@
+#ifndef SERIALREADER_HPP
+#define SERIALREADER_HPP
+
+#include "accframe.hpp"
+#include "accsample.hpp"
+#include "spscring.hpp"
+#include <QObject>
+#include <QSerialPort>
+#include <QString>
+#include <atomic>
+#include <cstddef>
+
+class QThread;
+class SerialReader;
+
+/**
+ * @brief Część czytnika działająca w wątku roboczym.
+ *
+ * Jest właścicielem QSerialPort, parsuje ramki i wstawia próbki do pierścienia
+ * SerialReader. Nie jest używana bezpośrednio poza SerialReader.
+ *
+ * Znacznik czasu próbki pochodzi z zegara urządzenia przeniesionego na zegar
+ * monotoniczny hosta, a nie z chwili odczytu – ramki z jednego odczytu portu
+ * zachowują swoje odstępy, a opóźnienia sterownika i wątku nie zaginają osi czasu.
+ */
+class SerialWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialWorker(SerialReader* reader);
+
+public slots:
+    void open(const QString& portName, qint32 baudRate);
+    void close();
+
+signals:
+    void opened();
+    void closed();
+    void errorOccurred(const QString& message);
+
+private slots:
+    void readPending();
+    void handleError(QSerialPort::SerialPortError error);
+
+private:
+    // Czas urządzenia [us] -> znacznik hosta [ns]; arrival – chwila odczytu porcji
+    std::int64_t hostTimestamp(std::uint32_t deviceTimeUs, std::int64_t arrival);
+
+    SerialReader* m_reader;
+    QSerialPort* m_port = nullptr;
+    AccFrameParser m_parser;
+    bool m_clockValid = false;
+    std::uint32_t m_lastDeviceUs = 0;
+    std::int64_t m_deviceBaseUs = 0;   ///< Suma zawinięć 32-bitowego licznika urządzenia.
+    std::int64_t m_clockOffset = 0;    ///< Znacznik hosta [ns] odpowiadający czasowi urządzenia 0.
+    std::int64_t m_lastTimestamp = 0;
+};
+
+/**
+ * @brief Odczyt telemetrii z portu szeregowego w dedykowanym wątku.
+ *
+ * Próbki trafiają do bezblokadowego pierścienia SPSC, z którego wątek GUI pobiera je
+ * porcjami. Sygnał samplesAvailable() jest emitowany tylko przy przejściu pierścienia
+ * ze stanu "opróżniony" w "niepusty", więc pętla zdarzeń GUI dostaje jedno zdarzenie
+ * na porcję, a nie na każdą próbkę. Nazwą portu może być też pseudo-terminal (np. /dev/pts/3).
+ */
+class SerialReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SerialReader(QObject* parent = nullptr, std::size_t ringCapacity = 16384);
+    ~SerialReader();
+
+    void start(const QString& portName, qint32 baudRate = 115200);
+    void stop();
+    bool isRunning() const;
+
+    // Pobranie oczekujących próbek (tylko wątek GUI); zwraca liczbę skopiowanych do out
+    std::size_t drain(AccSample* out, std::size_t maxCount);
+
+    quint64 droppedSamples() const;
+    AccFrameParser::Stats parserStats() const;
+
+signals:
+    void samplesAvailable();
+    void started();
+    void stopped();
+    void errorOccurred(const QString& message);
+
+private:
+    friend class SerialWorker;
+
+    // Wywoływane z wątku roboczego dla każdej zdekodowanej ramki
+    void pushSample(const AccSample& sample);
+    // Wywoływane z wątku roboczego po przetworzeniu porcji danych z portu
+    void notifyConsumer();
+    void publishStats(const AccFrameParser::Stats& stats);
+
+    QThread* m_thread;
+    SerialWorker* m_worker;
+    SpscRing<AccSample> m_ring;
+    bool m_running = false;
+
+    std::atomic<bool> m_notifyPending{false};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_frames{0};
+    std::atomic<quint64> m_crcErrors{0};
+    std::atomic<quint64> m_skippedBytes{0};
+    std::atomic<quint64> m_lostFrames{0};
+};
+
+#endif // SERIALREADER_HPP
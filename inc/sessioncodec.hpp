@@ -0,0 +1,66 @@
+#ifndef SESSIONCODEC_HPP
+#define SESSIONCODEC_HPP
+
+#include "accsample.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Układ skompresowanego eksportu sesji (*.accz).
+ *
+ *  - FileHeader,
+ *  - dowolna liczba bloków: BlockHeader + payloadBytes bajtów danych (dopełnionych do 8).
+ *
+ * Każdy blok zawiera próbki jednego strumienia i jest kodowany od zera, więc da się go
+ * odczytać bez poprzednich – plik przerwany w trakcie zapisu traci najwyżej ostatni blok,
+ * a dekoder po uszkodzeniu szuka następnego znacznika BlockMagic.
+ *
+ * Dane bloku (strumień bitów, od najstarszego bitu):
+ *  - znaczniki czasu jako różnica różnic (delta-of-delta) w kubełkach o zmiennej długości;
+ *    równe odstępy kosztują 1 bit na próbkę,
+ *  - osie X, Y, Z jako XOR z poprzednią wartością tej osi (kodowanie z Gorilla, Facebook):
+ *    powtórzona wartość – 1 bit, w pozostałych przypadkach tylko bity znaczące XOR.
+ */
+namespace SessionExportFormat {
+
+constexpr char FileMagic[8] = {'A', 'C', 'C', 'G', 'O', 'R', '0', '1'};
+constexpr std::uint32_t Version = 1;
+constexpr std::uint32_t BlockMagic = 0x4B4C4247; // "GBLK"
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+};
+
+struct BlockHeader
+{
+    std::uint32_t magic;
+    std::uint32_t streamId;
+    std::uint32_t count;          ///< Liczba próbek (co najmniej 1).
+    std::uint32_t payloadBytes;   ///< Długość danych po nagłówku, wielokrotność 8.
+    std::int64_t firstTimestamp;
+    std::int64_t lastTimestamp;
+};
+
+static_assert(sizeof(FileHeader) % 8 == 0, "FileHeader musi zachować wyrównanie bloków");
+static_assert(sizeof(BlockHeader) % 8 == 0, "BlockHeader musi zachować wyrównanie bloków");
+
+} // namespace SessionExportFormat
+
+namespace SessionCodec {
+
+// Dopisanie do out zakodowanego bloku (nagłówek + dane) z count > 0 próbek jednego strumienia
+void encodeBlock(std::uint32_t streamId, const AccSample* samples, std::size_t count,
+                 std::vector<std::uint8_t>& out);
+
+// Dekodowanie bloku z początku data; false, gdy brakuje danych albo blok jest uszkodzony.
+// W out trafiają próbki bloku, w consumed – długość bloku w bajtach.
+bool decodeBlock(const std::uint8_t* data, std::size_t size, SessionExportFormat::BlockHeader& header,
+                 std::vector<AccSample>& out, std::size_t& consumed);
+
+} // namespace SessionCodec
+
+#endif // SESSIONCODEC_HPP
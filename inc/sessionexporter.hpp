@@ -0,0 +1,86 @@
+#ifndef SESSIONEXPORTER_HPP
+#define SESSIONEXPORTER_HPP
+
+#include "accsampleblock.hpp"
+#include "sessioncodec.hpp"
+#include <QFile>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+#include <map>
+#include <vector>
+
+class QThread;
+
+/**
+ * @brief Skompresowany eksport wszystkich strumieni sesji do pliku *.accz.
+ *
+ * Działa jak FlightRecorder: record() tylko odkłada blok strumienia do kolejki
+ * (jest bezpieczne wątkowo – wywołują je bezpośrednio wątki puli SimulationController),
+ * a kodowaniem (SessionCodec) i zapisem zajmuje się osobny wątek. Próbki każdego
+ * strumienia są zbierane do bloków po BlockSamples; niepełne bloki trafiają na dysk
+ * najpóźniej po FlushIntervalMs. Przy zatorze kolejne bloki są odrzucane i liczone.
+ * Błąd zapisu kończy eksport: wątek zapisu przestaje pracować i emituje writeFailed().
+ */
+class SessionExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SessionExporter(QObject *parent = nullptr);
+    ~SessionExporter();
+
+    bool start(const QString& path);
+    // Zakodowanie zaległych próbek i zamknięcie pliku
+    void stop();
+    bool isExporting() const;
+
+    QString errorString() const;
+    quint64 exportedSamples() const;
+    quint64 droppedSamples() const;
+    quint64 bytesWritten() const;
+
+public slots:
+    void record(int streamId, const AccSampleBlock& block);
+
+signals:
+    // Błąd zapisu (np. brak miejsca na dysku) – wątek zapisu skończył pracę, należy wywołać stop()
+    void writeFailed(const QString& message);
+
+private:
+    void writerLoop();
+    void append(int streamId, const AccSampleBlock& block);
+    void writeBlock(int streamId, std::vector<AccSample>& samples);
+    void writeBuffers();
+    bool writeAll(const void* data, qint64 size);
+    bool flushFile();
+    void fail(const QString& message);
+
+    QThread* writerThread = nullptr;
+    mutable QMutex mutex;
+    QWaitCondition wake;
+    QVector<QPair<int, AccSampleBlock>> pending; ///< Bloki czekające na kodowanie (chronione mutex).
+    qsizetype pendingSamples = 0;
+    bool stopRequested = false;
+    bool accepting = false;             ///< record() przyjmuje bloki (chronione mutex; wywołania z wątków puli).
+
+    // Stan używany wyłącznie przez wątek zapisu
+    QFile file;
+    std::map<int, std::vector<AccSample>> buffers; ///< Niepełne bloki strumieni.
+    std::vector<std::uint8_t> encoded;
+
+    QString error;                      ///< Chronione mutex (ustawiane też przez wątek zapisu).
+    std::atomic<bool> failed{false};    ///< Zapis przerwany błędem – kolejne bloki są odrzucane.
+    std::atomic<quint64> exported{0};
+    std::atomic<quint64> dropped{0};
+    std::atomic<quint64> bytes{0};
+
+    static constexpr std::size_t BlockSamples = 4096;      ///< Próbek w pełnym bloku.
+    static constexpr int FlushIntervalMs = 1000;           ///< Niepełne bloki trafiają na dysk najpóźniej po tym czasie.
+    static constexpr qsizetype MaxPendingSamples = 1 << 21;
+};
+
+#endif // SESSIONEXPORTER_HPP
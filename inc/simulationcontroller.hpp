@@ -1,23 +1,147 @@
 #ifndef SIMULATIONCONTROLLER_HPP
 #define SIMULATIONCONTROLLER_HPP
 
+#include "accsampleblock.hpp"
+#include "dspfilters.hpp"
+#include "eventdetector.hpp"
+#include <QList>
+#include <QMetaType>
 #include <QObject>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
-class AccSimulator;
+class SampleSource;
+class WorkStealingPool;
+namespace TelemetryShm { class Writer; }
+
+Q_DECLARE_METATYPE(EventDetector::Event)
+
+/**
+ * @brief Zarządza strumieniami danych (czujnikami / dronami) i ich torami przetwarzania.
+ *
+ * Każdy strumień ma własne źródło i własny łańcuch filtrów. Strumienie nie mają
+ * własnych wątków: jeden wątek harmonogramu co takt zleca ograniczonej puli
+ * wątków z kradzieżą zadań obsługę każdego aktywnego strumienia (poll źródła,
+ * wykrywanie zdarzeń, filtracja). Bloki wszystkich strumieni trafiają do odbiorców
+ * streamBlock() (magazyn, eksport) jeszcze w wątkach puli; do wątku GUI idzie tylko
+ * strumień 0 i zdarzenia detektora, zebrane w jedno zdarzenie kolejki naraz – koszt
+ * po stronie GUI nie rośnie z liczbą strumieni.
+ * Strumień 0 istnieje zawsze – to on zasila wyświetlacze, widmo i rejestrator.
+ */
 class SimulationController : public QObject
 {
     Q_OBJECT
 
 public:
+    static constexpr int PrimaryStream = 0;
+
     explicit SimulationController(QObject *parent = nullptr);
+    ~SimulationController();
 
     void startSimulation();
     void stopSimulation();
     bool isRunning() const;
+
+    // Częstotliwość próbkowania symulatorów w Hz (do AccSimulator::MaxSampleRate)
+    void setSampleRate(double hz);
+    double sampleRate() const;
+    // Próbki porzucone przez symulatory, bo nie nadążały z generowaniem
+    quint64 droppedSamples() const;
+
+    // Ziarno bazowe symulatorów (strumień n: seed + n) – to samo ziarno daje te same dane
+    void setSeed(quint64 seed);
+    quint64 seed() const;
+
+    // Podmiana źródła strumienia 0 (np. na odtwarzanie nagrania); kontroler przejmuje własność.
+    // nullptr przywraca wbudowany symulator.
+    void setSource(SampleSource* newSource);
+
+    // Dodatkowy strumień z własnym źródłem (kontroler przejmuje własność); zwraca jego identyfikator
+    int addSource(SampleSource* source, const QString& name);
+    void removeSource(int id);
+    // Liczba symulowanych strumieni razem ze strumieniem 0 – nadmiarowe są dodawane lub usuwane
+    void setSimulatedStreams(int count);
+    QList<int> streamIds() const;
+    QString streamName(int id) const;
+    std::size_t workerCount() const;
+
+    // Łańcuch filtrów strumienia (nullptr – bez filtrów); filtry mają stan, więc każdy strumień potrzebuje własnego
+    void setFilterChain(int streamId, std::shared_ptr<dsp::FilterChain> chain);
+
+    // Reguły detektora zdarzeń wspólne dla wszystkich strumieni (nullptr – bez wykrywania).
+    // Reguły są oceniane w wątkach puli na surowych próbkach; domyślnie EventDetector::defaultRules().
+    void setEventRules(std::shared_ptr<const EventDetector::RuleSet> rules);
+    std::shared_ptr<const EventDetector::RuleSet> eventRules() const;
+
+    // Wprowadzenie bloku z zewnętrznego źródła (np. portu szeregowego) do toru strumienia 0.
+    // Źródłem strumienia 0 musi być ExternalSource (setSource()); w przeciwnym razie blok jest pomijany.
+    void pushExternalBlock(const AccSampleBlock& block);
+
+    // Publikacja bloków wszystkich strumieni po filtracji do pierścienia w pamięci współdzielonej
+    // (TelemetryShm) – dla lokalnych procesów analizy. Pierścień zapisuje wątek harmonogramu,
+    // na początku taktu następującego po obsłudze bloku.
+    bool startSharedMemory(const QString& name, QString* error = nullptr);
+    void stopSharedMemory();
+    bool isSharingMemory() const;
 signals:
-    void newData(double x, double y, double z);
+    // Dane po filtracji strumienia 0 – dla wyświetlaczy i wykresów
+    void newBlock(const AccSampleBlock& block);
+    // Surowe dane strumienia 0 – dla rejestratora
+    void rawBlock(const AccSampleBlock& block);
+    // Dane po filtracji dowolnego strumienia – dla magazynu i eksportu. Emitowany w wątku puli:
+    // odbiorcy łączą się przez Qt::DirectConnection i muszą być bezpieczni wątkowo
+    void streamBlock(int streamId, const AccSampleBlock& block);
+    // Źródło lub częstotliwość strumienia zmieniły się – nominalny odstęp próbek trzeba wyznaczyć
+    // od nowa. Emitowany w wątku puli tuż przed pierwszym blokiem nowego taktowania (jak streamBlock)
+    void intervalReset(int streamId);
+    // Zdarzenie rozpoznane przez detektor strumienia (zgłoszenie lub odwołanie)
+    void detectorEvent(int streamId, const EventDetector::Event& event);
+    void streamAdded(int streamId, const QString& name);
+    void streamRemoved(int streamId);
+    void sourceFinished();
 private:
-    AccSimulator* simulator; ///< Wskaźnik do obiektu generującego dane symulacyjne.
+    struct Stream;
+
+    int addStream(SampleSource* source, const QString& name);
+    std::shared_ptr<Stream> findStream(int id) const;
+    void schedulerLoop();
+    void publishShared(const std::vector<std::shared_ptr<Stream>>& snapshot);
+    void runStream(Stream& stream, std::int64_t now);
+    void postToGui(int id, const AccSampleBlock& filtered, const std::vector<EventDetector::Event>& events);
+    void deliverToGui();
+
+    mutable std::mutex streamsMutex;
+    std::vector<std::shared_ptr<Stream>> streams; ///< Chronione streamsMutex; harmonogram bierze kopię.
+    std::vector<int> simulatedIds;                ///< Dodatkowe strumienie z setSimulatedStreams().
+    std::shared_ptr<const EventDetector::RuleSet> rules; ///< Reguły dla nowych strumieni (chronione streamsMutex).
+    int nextStreamId = PrimaryStream;
+    std::atomic<double> rate{20.0};
+    std::atomic<quint64> baseSeed{1};
+
+    // Dane dla wątku GUI zebrane od ostatniego powiadomienia (chronione outboxMutex)
+    struct Outbox
+    {
+        AccSampleBlock primary;                                  ///< Próbki strumienia 0.
+        std::vector<std::pair<int, EventDetector::Event>> events;
+        std::vector<std::pair<std::int64_t, int>> blocks;       ///< Najstarsza próbka i rozmiar bloku – pomiar kolejki.
+        bool posted = false;                                     ///< Powiadomienie czeka w kolejce zdarzeń.
+    };
+    std::mutex outboxMutex;
+    Outbox outbox;
+
+    mutable std::mutex shmMutex;                  ///< Chroni shmWriter; publikuje tylko wątek harmonogramu.
+    std::unique_ptr<TelemetryShm::Writer> shmWriter;
+    std::vector<AccSampleBlock> shmBlocks;        ///< Bufor roboczy harmonogramu do publikacji.
+    std::atomic<bool> shmActive{false};
+
+    std::unique_ptr<WorkStealingPool> pool;       ///< Wspólne wątki robocze wszystkich strumieni.
+    std::thread scheduler;                        ///< Wątek taktujący strumienie.
+    std::atomic<bool> stopping{false};
+    static constexpr int TickMs = 10;             ///< Okres odpytywania źródeł.
 };
 
 #endif // SIMULATIONCONTROLLER_HPP
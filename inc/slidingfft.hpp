@@ -0,0 +1,54 @@
+#ifndef SLIDINGFFT_HPP
+#define SLIDINGFFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dsp {
+
+/**
+ * @brief FFT w przesuwanym oknie z nakładaniem (okno Hanna).
+ *
+ * Próbki są dopisywane do bufora cyklicznego o długości okna; co @c hop próbek
+ * liczona jest FFT radix-2 ostatnich @c size próbek. Okno, współczynniki obrotu
+ * i permutacja odwracania bitów są liczone raz, w konstruktorze.
+ */
+class SlidingFft
+{
+public:
+    // size musi być potęgą dwójki; hop == 0 oznacza nakładanie 50%
+    explicit SlidingFft(std::size_t size = 1024, std::size_t hop = 0);
+
+    // Dopisanie próbki; zwraca true, gdy gotowa jest nowa ramka widma (magnitudes())
+    bool push(double value);
+
+    // Amplitudy prążków 0..size/2 ostatniej ramki (skalowane do amplitudy sinusoidy)
+    const std::vector<float>& magnitudes() const { return m_magnitudes; }
+
+    void reset();
+    std::size_t size() const { return m_size; }
+    std::size_t hop() const { return m_hop; }
+    std::size_t bins() const { return m_size / 2 + 1; }
+
+private:
+    void compute();
+
+    std::size_t m_size;
+    std::size_t m_hop;
+    std::vector<double> m_window;                  ///< Współczynniki okna Hanna.
+    std::vector<std::complex<double>> m_twiddles;  ///< exp(-2*pi*i*k/size), k < size/2.
+    std::vector<std::uint32_t> m_bitReverse;
+    std::vector<double> m_history;                 ///< Bufor cykliczny ostatnich size próbek.
+    std::vector<std::complex<double>> m_work;
+    std::vector<float> m_magnitudes;
+    std::size_t m_pos = 0;
+    std::size_t m_filled = 0;
+    std::size_t m_sinceLast = 0;
+    double m_windowGain = 1.0;
+};
+
+} // namespace dsp
+
+#endif // SLIDINGFFT_HPP
@@ -0,0 +1,61 @@
+#ifndef SPECTRUMANALYZER_HPP
+#define SPECTRUMANALYZER_HPP
+
+#include "accsampleblock.hpp"
+#include "slidingfft.hpp"
+#include <QMetaType>
+#include <QObject>
+#include <QVector>
+#include <memory>
+
+/**
+ * @brief Jedna ramka widma przekazywana do GUI.
+ *
+ * Wektor amplitud jest współdzielony niejawnie – sygnał kolejkowany przenosi tylko uchwyt,
+ * a analizator po wysłaniu ramki już jej nie modyfikuje.
+ */
+struct SpectrumFrame
+{
+    qint64 timestamp = 0;      ///< Znacznik czasu ostatniej próbki w oknie [ns].
+    double binHz = 0.0;        ///< Szerokość prążka [Hz].
+    QVector<float> magnitudes; ///< Amplitudy prążków 0..N/2.
+};
+
+Q_DECLARE_METATYPE(SpectrumFrame)
+
+/**
+ * @brief Analizator widma pracujący w wątku roboczym.
+ *
+ * Przyjmuje bloki próbek (process() wołane przez połączenie kolejkowane), liczy FFT
+ * w przesuwanym oknie i emituje gotowe ramki. Częstotliwość próbkowania jest
+ * szacowana ze znaczników czasu, więc działa tak samo dla symulatora, portu i nagrań.
+ */
+class SpectrumAnalyzer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Channel { X, Y, Z, Magnitude };
+
+    explicit SpectrumAnalyzer(QObject *parent = nullptr);
+
+    // Zmiana rozmiaru okna i analizowanej osi; bezpieczna z dowolnego wątku
+    void configure(int fftSize, Channel channel);
+
+public slots:
+    void process(const AccSampleBlock& block);
+
+signals:
+    void frameReady(const SpectrumFrame& frame);
+
+private:
+    void apply(int fftSize, Channel channel);
+
+    std::unique_ptr<dsp::SlidingFft> m_fft;
+    Channel m_channel = Channel::Z;
+    qint64 m_lastFrameTime = 0;     ///< Znacznik czasu poprzedniej ramki.
+    qint64 m_samplesSinceFrame = 0;
+    double m_sampleRate = 0.0;      ///< Oszacowana częstotliwość próbkowania [Hz].
+};
+
+#endif // SPECTRUMANALYZER_HPP
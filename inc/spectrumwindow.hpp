@@ -0,0 +1,65 @@
+#ifndef SPECTRUMWINDOW_HPP
+#define SPECTRUMWINDOW_HPP
+
+#include "spectrumanalyzer.hpp"
+#include <QComboBox>
+#include <QImage>
+#include <QLabel>
+#include <QWidget>
+
+class QThread;
+
+/**
+ * @brief Obszar rysowania: widmo bieżącej ramki (góra) i spektrogram (dół).
+ *
+ * Spektrogram jest obrazem o stałej liczbie wierszy, zapisywanym cyklicznie –
+ * nowa ramka to jeden wiersz, bez przesuwania całego obrazu w pamięci.
+ */
+class SpectrumView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumView(QWidget *parent = nullptr);
+
+public slots:
+    void addFrame(const SpectrumFrame& frame);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    QRgb colorFor(float magnitude) const;
+
+    SpectrumFrame lastFrame;
+    QImage spectrogram;
+    int nextRow = 0;          ///< Wiersz spektrogramu, do którego trafi następna ramka.
+    QRgb palette[256];        ///< Mapa kolorów dla poziomu w dB.
+    const int historyRows = 300;
+    const float minDb = -80.0f;
+    const float maxDb = 10.0f;
+};
+
+class SpectrumWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumWindow(QWidget *parent = nullptr);
+    ~SpectrumWindow();
+
+    // Analizator żyje w osobnym wątku; do jego slotu process() podłącza się źródło bloków
+    SpectrumAnalyzer* analyzer() const;
+
+private slots:
+    void reconfigure();
+
+private:
+    QThread* analyzerThread;
+    SpectrumAnalyzer* spectrumAnalyzer;
+    SpectrumView* view;
+    QComboBox* sizeCombo;
+    QComboBox* channelCombo;
+};
+
+#endif // SPECTRUMWINDOW_HPP
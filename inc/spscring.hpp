@@ -0,0 +1,106 @@
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief Bezblokadowy bufor pierścieniowy dla jednego producenta i jednego konsumenta.
+ *
+ * Producent wywołuje wyłącznie push(), konsument wyłącznie pop()/popMany().
+ * Pojemność jest zaokrąglana w górę do potęgi dwójki, indeksy rosną monotonicznie,
+ * a pozycję w tablicy wyznacza maska – dzięki temu nie ma dzielenia modulo.
+ */
+template <typename T>
+class SpscRing
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpscRing przechowuje wyłącznie typy trywialnie kopiowalne");
+
+public:
+    explicit SpscRing(std::size_t capacity)
+        : m_capacity(roundUpPow2(capacity))
+        , m_mask(m_capacity - 1)
+        , m_buffer(new T[m_capacity])
+    {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Wstawienie elementu (tylko wątek producenta); false, gdy bufor jest pełny
+    bool push(const T& value)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tailCache == m_capacity) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+            if (head - m_tailCache == m_capacity)
+                return false;
+        }
+        m_buffer[head & m_mask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pobranie elementu (tylko wątek konsumenta); false, gdy bufor jest pusty
+    bool pop(T& value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_headCache) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+            if (tail == m_headCache)
+                return false;
+        }
+        value = m_buffer[tail & m_mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pobranie do maxCount elementów naraz (tylko wątek konsumenta); zwraca liczbę pobranych
+    std::size_t popMany(T* out, std::size_t maxCount)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        m_headCache = m_head.load(std::memory_order_acquire);
+        std::size_t count = m_headCache - tail;
+        if (count > maxCount)
+            count = maxCount;
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = m_buffer[(tail + i) & m_mask];
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Przybliżona liczba elementów w buforze (dokładna tylko z wątku konsumenta lub producenta)
+    std::size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    static std::size_t roundUpPow2(std::size_t value)
+    {
+        std::size_t result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    // Rozmiar linii pamięci podręcznej – rozdziela indeksy producenta i konsumenta (brak false sharing)
+    static constexpr std::size_t CacheLine = 64;
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<T[]> m_buffer;
+
+    alignas(CacheLine) std::atomic<std::size_t> m_head{0}; ///< Zapisywany przez producenta.
+    std::size_t m_tailCache = 0;                            ///< Kopia m_tail widziana przez producenta.
+
+    alignas(CacheLine) std::atomic<std::size_t> m_tail{0}; ///< Zapisywany przez konsumenta.
+    std::size_t m_headCache = 0;                            ///< Kopia m_head widziana przez konsumenta.
+};
+
+#endif // SPSCRING_HPP
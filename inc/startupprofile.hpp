@@ -0,0 +1,35 @@
+#ifndef STARTUPPROFILE_HPP
+#define STARTUPPROFILE_HPP
+
+#include <QString>
+#include <cstdint>
+#include <functional>
+
+class QWidget;
+
+/**
+ * @brief Pomiar zimnego startu: znaczniki kolejnych etapów od uruchomienia procesu do pierwszej klatki.
+ *
+ * Punktem odniesienia jest chwila utworzenia procesu (w Linuksie z /proc/self/stat, z dokładnością
+ * do taktu zegara jądra), więc wynik obejmuje też ładowanie bibliotek i inicjalizację statyczną.
+ * Na innych systemach – inicjalizacja statyczna tego modułu. Znaczniki są zapisywane tylko
+ * w wątku GUI.
+ */
+namespace StartupProfile {
+
+// Chwila startu procesu [ns] w podstawie czasu accTimestampNow()
+std::int64_t processStart();
+
+// Zakończenie etapu startu o podanej nazwie
+void mark(const char* phase);
+
+// Etapy od startu procesu, np. "main 21.4 ms, application 35.0 ms, ..."
+QString summary();
+
+// Jednorazowe wywołanie callback przy pierwszym rysowaniu widgetu (okna najwyższego poziomu),
+// z chwilą rozpoczęcia rysowania [ns]
+void onFirstPaint(QWidget* widget, std::function<void(std::int64_t)> callback);
+
+} // namespace StartupProfile
+
+#endif // STARTUPPROFILE_HPP
@@ -0,0 +1,32 @@
+#ifndef STATSPANEL_HPP
+#define STATSPANEL_HPP
+
+#include "pipelinestats.hpp"
+#include <QTableWidget>
+#include <QTimer>
+#include <QWidget>
+
+/**
+ * @brief Panel statystyk toru danych: częstotliwości, opóźnienia, straty i kolejki.
+ *
+ * Odświeżany dwa razy na sekundę z migawek PipelineStats; przycisk zapisuje
+ * bieżącą migawkę do pliku JSON.
+ */
+class StatsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StatsPanel(QWidget *parent = nullptr);
+
+public slots:
+    void refresh();
+    void dumpJson();
+
+private:
+    QTableWidget* table;
+    QTimer* refreshTimer;
+    PipelineStats::Snapshot previous;
+};
+
+#endif // STATSPANEL_HPP
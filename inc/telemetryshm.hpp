@@ -0,0 +1,169 @@
+#ifndef TELEMETRYSHM_HPP
+#define TELEMETRYSHM_HPP
+
+#include "accsample.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Pierścień próbek w pamięci współdzielonej POSIX (shm_open) dla procesów analizy.
+ *
+ * Jeden pisarz (aplikacja), dowolna liczba czytelników, bez blokad. Pierścień składa się
+ * z gniazd po slotSamples próbek jednego strumienia; blok o numerze n trafia do gniazda
+ * n % slotCount. Każde gniazdo ma licznik wersji jak seqlock: 2n + 1 w trakcie zapisu
+ * bloku n, 2n + 2 po jego zakończeniu. Czytelnik sprawdza wersję przed i po odczycie,
+ * więc wie, czy dane nie zostały w tym czasie nadpisane.
+ *
+ * Pisarz nigdy nie czeka na czytelników: wolny czytelnik wykrywa nadpisanie (overrun),
+ * liczy utracone bloki i przeskakuje do danych, które są jeszcze w pierścieniu.
+ * Zamknięcie pisarza jest zaznaczane w nagłówku (closed): czytelnik po odczytaniu reszty
+ * bloków dostaje Status::Closed i może otworzyć segment ponownie, gdy aplikacja utworzy nowy.
+ * Nagłówek pliku nie zależy od Qt – z tego pliku korzystają też narzędzia zewnętrzne.
+ */
+namespace TelemetryShm {
+
+constexpr char Magic[8] = {'A', 'C', 'C', 'S', 'H', 'M', '0', '1'};
+constexpr std::uint32_t Version = 1;
+constexpr const char* DefaultName = "/qtdrone-telemetry";
+
+struct alignas(64) RingHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t slotSamples;
+    std::uint32_t slotBytes;               ///< Rozmiar gniazda razem z nagłówkiem (wielokrotność 64).
+    std::uint32_t sampleSize;              ///< sizeof(AccSample) pisarza.
+    std::atomic<std::uint32_t> closed;     ///< 1 – pisarz zamknął segment, nowych bloków nie będzie (dawniej pole zarezerwowane, 0).
+    std::atomic<std::uint64_t> published;  ///< Liczba zakończonych bloków = numer następnego.
+};
+
+struct alignas(64) SlotHeader
+{
+    std::atomic<std::uint64_t> version;    ///< 2n + 1 – zapis bloku n, 2n + 2 – blok n gotowy.
+    std::uint32_t streamId;
+    std::uint32_t count;                   ///< Próbek w bloku (do slotSamples).
+};
+
+// Datagram mostu (narzędzie shmbridge) dla odbiorców bez dostępu do pamięci współdzielonej:
+// nagłówek + count próbek, jeden blok pierścienia na datagram
+constexpr std::uint32_t DatagramMagic = 0x42434341; // "ACCB"
+
+struct DatagramHeader
+{
+    std::uint32_t magic;
+    std::uint32_t streamId;
+    std::uint64_t sequence;    ///< Numer bloku w pierścieniu – luki oznaczają bloki utracone.
+    std::uint32_t count;
+    std::uint32_t reserved;
+};
+
+static_assert(sizeof(DatagramHeader) % 8 == 0, "Próbki datagramu muszą być wyrównane");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<std::uint32_t>::is_always_lock_free,
+              "Liczniki w pamięci współdzielonej muszą być bezblokadowe");
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "Układ nagłówka pierścienia");
+static_assert(sizeof(SlotHeader) % alignof(AccSample) == 0, "Próbki gniazda muszą być wyrównane");
+
+/**
+ * @brief Strona aplikacji: tworzy pierścień i publikuje do niego bloki.
+ *
+ * publish() może wywoływać tylko jeden wątek naraz.
+ */
+class Writer
+{
+public:
+    Writer() = default;
+    ~Writer();
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    // Utworzenie (albo zastąpienie) segmentu o nazwie name, np. "/qtdrone-telemetry"
+    bool open(const std::string& name, std::uint32_t slotCount = 1024, std::uint32_t slotSamples = 256);
+    // Oznaczenie segmentu jako zamkniętego, odłączenie i usunięcie; podłączeni czytelnicy zachowują
+    // swoje odwzorowanie, a po odczytaniu reszty bloków dostają Status::Closed
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    const std::string& errorString() const { return m_error; }
+
+    // Blok próbek jednego strumienia; dłuższe niż slotSamples zajmują kolejne gniazda
+    void publish(std::uint32_t streamId, const AccSample* samples, std::size_t count);
+    std::uint64_t publishedBlocks() const { return m_sequence; }
+
+private:
+    RingHeader* m_header = nullptr;
+    std::size_t m_size = 0;
+    std::uint64_t m_sequence = 0;
+    std::string m_name;
+    std::string m_error;
+};
+
+/**
+ * @brief Strona klienta: odczyt bloków z pierścienia bez blokowania pisarza.
+ *
+ * Po otwarciu czytelnik zaczyna od najnowszych danych. next() kopiuje blok, a view()
+ * i release() pozwalają czytać próbki bezpośrednio z pamięci współdzielonej – wynik
+ * przetwarzania jest ważny tylko wtedy, gdy release() zwróci true.
+ */
+class Reader
+{
+public:
+    enum class Status {
+        Ok,       ///< Odczytano blok.
+        Empty,    ///< Brak nowego bloku – spróbować później.
+        Overrun,  ///< Czytelnik nie nadążył; utracone bloki dodano do lostBlocks(), odczyt wznowiony.
+        Closed    ///< Pisarz zamknął segment i wszystkie bloki odczytano – close() i ponowne open().
+    };
+
+    struct Block
+    {
+        std::uint64_t sequence = 0;
+        std::uint32_t streamId = 0;
+        std::vector<AccSample> samples;
+    };
+
+    struct View
+    {
+        std::uint64_t sequence = 0;
+        std::uint32_t streamId = 0;
+        const AccSample* samples = nullptr; ///< Wskazuje do pamięci współdzielonej.
+        std::size_t count = 0;
+        std::uint64_t version = 0;
+    };
+
+    Reader() = default;
+    ~Reader();
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    bool open(const std::string& name = DefaultName);
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    const std::string& errorString() const { return m_error; }
+
+    Status next(Block& block);
+    Status view(View& view);
+    // Potwierdzenie odczytu z view(): false – blok nadpisano w trakcie, wynik trzeba odrzucić
+    bool release(const View& view);
+
+    std::uint64_t lostBlocks() const { return m_lost; }
+    std::uint64_t overruns() const { return m_overruns; }
+    std::uint32_t slotSamples() const;
+
+private:
+    const SlotHeader* slotAt(std::uint64_t sequence) const;
+    void skipAhead();
+
+    const RingHeader* m_header = nullptr;
+    std::size_t m_size = 0;
+    std::uint64_t m_next = 0;
+    std::uint64_t m_lost = 0;
+    std::uint64_t m_overruns = 0;
+    std::string m_error;
+};
+
+} // namespace TelemetryShm
+
+#endif // TELEMETRYSHM_HPP
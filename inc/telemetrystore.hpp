@@ -0,0 +1,158 @@
+#ifndef TELEMETRYSTORE_HPP
+#define TELEMETRYSTORE_HPP
+
+#include "accsampleblock.hpp"
+#include "intervaltracker.hpp"
+#include "minmaxpyramid.hpp"
+#include <QList>
+#include <QObject>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Wspólny dla procesu magazyn przebiegów czasowych, niezależny od okien.
+ *
+ * Każda seria (strumień SimulationController) przechowuje surowe próbki kolumnowo
+ * – osobno czas, x, y i z – w porcjach o stałym rozmiarze z areny serii. Pełne
+ * porcje nie są przenoszone, a po przekroczeniu budżetu najstarsza porcja wraca do
+ * areny i jest użyta ponownie, więc dopisanie próbki nie alokuje pamięci. Obok surowych
+ * danych seria ma piramidy min/max do szybkiego przeglądu dowolnie długiego przedziału.
+ *
+ * Przy dopisywaniu magazyn wykrywa przerwy w danych (próbki spóźnione lub brakujące
+ * względem nominalnego odstępu serii), żeby wykresy mogły je zaznaczyć zamiast
+ * łączyć sąsiednie próbki linią.
+ *
+ * Widoki nie trzymają własnej kopii danych: subskrybują sygnał appended() i pytają
+ * o przedział czasu. Dopisywanie odbywa się w wątkach puli SimulationController:
+ * każda seria ma własny mutex i własną arenę porcji, więc strumienie nie blokują się
+ * nawzajem, a zapytania z wątku GUI czekają tylko na serię, o którą pytają. Dopisania
+ * z innych wątków są zbierane i ogłaszane jednym zdarzeniem w wątku magazynu, więc
+ * koszt po stronie GUI nie rośnie z liczbą strumieni.
+ */
+class TelemetryStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr std::size_t ChunkSamples = 4096;
+    static constexpr std::size_t MaxGaps = 4096;   ///< Zapamiętane przerwy jednej serii.
+
+    // Przerwa w danych: znaczniki [ns] ostatniej próbki przed nią i pierwszej po niej
+    struct Gap
+    {
+        qint64 start;
+        qint64 end;
+    };
+
+    // Budżety na jedną serię: surowe próbki i piramidy przeglądowe trzech osi
+    static constexpr std::size_t DefaultRawBudget = 64 * 1024 * 1024;
+    static constexpr std::size_t DefaultOverviewBudget = 6 * 1024 * 1024;
+    explicit TelemetryStore(std::size_t rawBudgetBytes = DefaultRawBudget,
+                            std::size_t overviewBudgetBytes = DefaultOverviewBudget,
+                            QObject *parent = nullptr);
+    ~TelemetryStore();
+
+    // Magazyn współdzielony przez wszystkie okna procesu; tworzony przy pierwszym wywołaniu
+    // jako dziecko QCoreApplication (musi już istnieć) i usuwany razem z nią
+    static TelemetryStore* instance();
+
+    void addSeries(int id, const QString& name);
+    void removeSeries(int id);
+    // Usunięcie danych serii bez jej usuwania (np. przełączenie na odtwarzanie nagrania)
+    void clearSeries(int id);
+    bool contains(int id) const;
+    QList<int> seriesIds() const;
+    QString seriesName(int id) const;
+
+    // Zachowane surowe próbki i ich zakres znaczników czasu [ns]
+    qint64 sampleCount(int id) const;
+    qint64 firstTimestamp(int id) const;
+    qint64 lastTimestamp(int id) const;
+    // Próbki odrzucone, bo miały ten sam znacznik co poprzednia
+    qint64 rejectedSamples(int id) const;
+
+    // Nominalny odstęp między próbkami serii [ns] (0 – jeszcze nieznany) i liczba wykrytych przerw
+    qint64 nominalInterval(int id) const;
+    qint64 gapCount(int id) const;
+    // Przerwy nachodzące na [t0, t1] [ns], od najstarszej; zwraca ich liczbę
+    std::size_t gaps(int id, qint64 t0, qint64 t1, std::vector<Gap>& out) const;
+
+    // Czas w sekundach od utworzenia magazynu – oś czasu piramid i wykresów
+    double toSeconds(qint64 timestamp) const;
+    qint64 fromSeconds(double seconds) const;
+
+    // Przegląd osi (0 = x, 1 = y, 2 = z): najwyżej ok. maxBuckets kubełków min/max z [t0, t1] [s]
+    void overview(int id, int axis, double t0, double t1, std::size_t maxBuckets,
+                  std::vector<MinMaxPyramid::Bucket>& out) const;
+    // Zakres czasu dostępny w przeglądzie [s]; false, gdy seria jest pusta
+    bool overviewRange(int id, double& oldest, double& newest) const;
+
+    // Surowe próbki o znacznikach z [t0, t1] [ns], najwyżej maxSamples; zwraca ich liczbę
+    std::size_t samples(int id, qint64 t0, qint64 t1, std::vector<AccSample>& out,
+                        std::size_t maxSamples = static_cast<std::size_t>(-1)) const;
+
+    std::size_t memoryBytes() const;
+
+public slots:
+    // Bezpieczne wątkowo; wywoływane zwykle w wątkach puli (połączenie Qt::DirectConnection)
+    void append(int id, const AccSampleBlock& block);
+    // Zapomnienie nominalnego odstępu serii (nowe źródło lub częstotliwość) bez usuwania danych
+    void resetInterval(int id);
+
+signals:
+    void seriesAdded(int id, const QString& name);
+    void seriesRemoved(int id);
+    // Dane serii usunięte – jawnie albo po cofnięciu się znaczników czasu
+    void seriesCleared(int id);
+    // Nowe próbki serii; lastTimestamp – znacznik najnowszej [ns]. Zawsze w wątku magazynu –
+    // dopisania z innych wątków są łączone w jedno zdarzenie na obrót pętli zdarzeń
+    void appended(int id, qint64 lastTimestamp);
+
+private:
+    struct Chunk
+    {
+        qint64 t[ChunkSamples];
+        double x[ChunkSamples];
+        double y[ChunkSamples];
+        double z[ChunkSamples];
+        std::size_t count = 0;
+    };
+
+    struct Series
+    {
+        mutable std::mutex mutex;    ///< Chroni wszystkie pola poza name.
+        QString name;
+        std::vector<std::unique_ptr<Chunk>> arena;   ///< Wszystkie porcje serii.
+        std::vector<Chunk*> freeChunks;              ///< Porcje gotowe do ponownego użycia.
+        std::deque<Chunk*> chunks;
+        std::unique_ptr<MinMaxPyramid> overview[3];
+        qint64 count = 0;
+        qint64 rejected = 0;
+        IntervalTracker interval;
+        std::deque<Gap> gaps;        ///< Najnowsze przerwy, najwyżej MaxGaps.
+        qint64 gapCount = 0;
+    };
+
+    std::shared_ptr<Series> find(int id) const;
+    // Wywoływane z zablokowanym Series::mutex
+    static Chunk* allocateChunk(Series& target);
+    static void clearLocked(Series& target);
+    static qint64 newestTimestamp(const Series& target);
+    void notifyAppended(int id, qint64 lastTimestamp);
+    void flushAppended();
+
+    mutable std::mutex seriesMutex;              ///< Chroni mapę series (nie same serie).
+    std::map<int, std::shared_ptr<Series>> series;
+    std::mutex appendedMutex;
+    std::vector<std::pair<int, qint64>> appendedPending; ///< Dopisania czekające na ogłoszenie (chronione appendedMutex).
+    bool appendedPosted = false;                 ///< Zdarzenie ogłaszające jest w kolejce (chronione appendedMutex).
+    std::size_t maxChunks;                       ///< Limit porcji jednej serii.
+    std::size_t overviewBudget;
+    std::int64_t epoch;                          ///< Znacznik czasu odpowiadający 0 s.
+};
+
+#endif // TELEMETRYSTORE_HPP
@@ -0,0 +1,58 @@
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pula wątków o stałym rozmiarze z kradzieżą zadań.
+ *
+ * Każdy wątek ma własną kolejkę: zadania zgłoszone z wnętrza puli trafiają do kolejki
+ * bieżącego wątku, zgłoszone z zewnątrz – po kolei do kolejnych kolejek. Wątek bierze
+ * najpierw najnowsze zadanie z własnej kolejki (LIFO, ciepła pamięć podręczna),
+ * a gdy jest pusta – kradnie najstarsze z cudzej (FIFO).
+ */
+class WorkStealingPool
+{
+public:
+    // threads == 0: liczba rdzeni pomniejszona o jeden (rdzeń dla wątku GUI), co najmniej 1
+    explicit WorkStealingPool(std::size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task);
+    std::size_t threadCount() const { return m_threads.size(); }
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(std::size_t index);
+    bool tryPop(std::size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_next{0};
+
+    // Uśpienie wątku: blokada tylko wokół oczekiwania, zgłoszenia biorą ją wyłącznie, gdy ktoś śpi
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    std::atomic<std::int64_t> m_pending{0};  ///< Zadania zgłoszone, jeszcze niepobrane (zwiększane przed wstawieniem).
+    std::atomic<std::int64_t> m_sleepers{0}; ///< Wątki w m_wake.wait().
+    bool m_stop = false;                     ///< Chronione m_sleepMutex.
+};
+
+#endif // WORKSTEALINGPOOL_HPP
@@ -1,4 +1,8 @@
 #include "SpinBoxController.hpp"
+#include "pipelinestats.hpp"
+#include <QDeadlineTimer>
+#include <algorithm>
+#include <cmath>
 
 SpinBoxController::SpinBoxController(QDoubleSpinBox* boxX,
                                      QDoubleSpinBox* boxY,
@@ -11,19 +15,121 @@ SpinBoxController::SpinBoxController(QDoubleSpinBox* boxX,
     , m_boxZ(boxZ)
 {
     // Wyświetl od razu wartości początkowe
-    updateAll(initialX, initialY, initialZ);
+    updateDisplay(m_boxX, initialX);
+    updateDisplay(m_boxY, initialY);
+    updateDisplay(m_boxZ, initialZ);
+
+    // Pola są odświeżane w stałym takcie, a nie przy każdej próbce
+    m_displayTimer = new QTimer(this);
+    connect(m_displayTimer, &QTimer::timeout, this, &SpinBoxController::refreshDisplay);
+    m_displayTimer->start(100);
+}
+
+void SpinBoxController::setMode(Mode mode)
+{
+    m_mode = mode;
+    m_count = 0;  // Przedział zebrany w poprzednim trybie nie musi mieć kompletnych min/max/sumy
+}
+
+void SpinBoxController::setDisplayInterval(int ms)
+{
+    m_displayTimer->setInterval(std::max(ms, 1));
+}
+
+void SpinBoxController::setPeakHold(int holdMs)
+{
+    m_peakHoldMs = std::max(holdMs, 0);
+    for (Accumulator& axis : m_axes)
+        axis.peakTime = 0;  // Nowe okno podtrzymania od najbliższej próbki
+}
+
+void SpinBoxController::Accumulator::add(double value, bool first)
+{
+    latest = value;
+    if (first) {
+        min = max = sum = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+        sum += value;
+    }
 }
 
+double SpinBoxController::Accumulator::value(Mode mode, qint64 count) const
+{
+    switch (mode) {
+    case Mode::Minimum:
+        return min;
+    case Mode::Average:
+        return sum / static_cast<double>(count);
+    case Mode::Maximum:
+        return max;
+    case Mode::Latest:
+        break;
+    }
+    return latest;
+}
+
+void SpinBoxController::accumulate(double x, double y, double z)
+{
+    const bool first = m_count == 0;
+    m_axes[0].add(x, first);
+    m_axes[1].add(y, first);
+    m_axes[2].add(z, first);
+    ++m_count;
+}
+
+// Pojedyncza próbka – tylko zapamiętanie, wyświetlenie w najbliższym takcie
 void SpinBoxController::updateAll(double x, double y, double z)
 {
-    updateDisplay(m_boxX, x);
-    updateDisplay(m_boxY, y);
-    updateDisplay(m_boxZ, z);
+    accumulate(x, y, z);
+}
+
+// Tryb "najnowsza" bez podtrzymania szczytu potrzebuje tylko ostatniej próbki bloku
+void SpinBoxController::updateBlock(const AccSampleBlock& block)
+{
+    if (block.isEmpty())
+        return;
+    if (m_mode == Mode::Latest && m_peakHoldMs == 0) {
+        const AccSample& last = block.last();
+        accumulate(last.x, last.y, last.z);
+        m_count += block.size() - 1;
+        return;
+    }
+    for (const AccSample& sample : block)
+        accumulate(sample.x, sample.y, sample.z);
+}
+
+void SpinBoxController::refreshDisplay()
+{
+    if (m_count == 0)
+        return;
+    PipelineStats::ScopedTimer stats(PipelineStats::Stage::SpinBox, m_count);
+    PipelineStats::addCoalesced(PipelineStats::Stage::SpinBox, m_count - 1);
+
+    QDoubleSpinBox* boxes[3] = {m_boxX, m_boxY, m_boxZ};
+    const qint64 now = QDeadlineTimer::current().deadline();
+    for (int i = 0; i < 3; ++i) {
+        Accumulator& axis = m_axes[i];
+        double value = axis.value(m_mode, m_count);
+        if (m_peakHoldMs > 0) {
+            // Szczyt z bieżącego przedziału; starszy niż okno podtrzymania jest zastępowany
+            const double candidate = std::fabs(axis.max) >= std::fabs(axis.min) ? axis.max : axis.min;
+            if (axis.peakTime == 0 || now - axis.peakTime > m_peakHoldMs
+                || std::fabs(candidate) >= std::fabs(axis.peak)) {
+                axis.peak = candidate;
+                axis.peakTime = now;
+            }
+            value = axis.peak;
+        }
+        updateDisplay(boxes[i], value);
+    }
+    m_count = 0;
 }
 
 void SpinBoxController::updateDisplay(QDoubleSpinBox* box, double value)
 {
     // Po prostu ustaw wartość – prefix/suffix/decimals/range
-    // są już skonfigurowane w Designerze.
+    // są już skonfigurowane w Designerze. Bez zmiany nie ma valueChanged ani przerysowania.
     box->setValue(value);
 }
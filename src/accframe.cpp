@@ -0,0 +1,112 @@
+#include "accframe.hpp"
+#include <cstring>
+
+namespace {
+
+void writeU16(std::uint8_t* out, std::uint16_t value)
+{
+    out[0] = static_cast<std::uint8_t>(value);
+    out[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void writeU32(std::uint8_t* out, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+std::uint16_t readU16(const std::uint8_t* in)
+{
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t* in)
+{
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+        value |= static_cast<std::uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+void writeFloat(std::uint8_t* out, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, bits);
+}
+
+float readFloat(const std::uint8_t* in)
+{
+    const std::uint32_t bits = readU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace
+
+std::uint16_t accCrc16(const std::uint8_t* data, std::size_t size)
+{
+    std::uint16_t crc = 0xFFFF;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<std::uint16_t>(data[i] << 8);
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x8000) ? static_cast<std::uint16_t>((crc << 1) ^ 0x1021)
+                                 : static_cast<std::uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+void encodeAccFrame(const AccFrame& frame, std::uint8_t out[AccFrameFormat::FrameSize])
+{
+    out[0] = AccFrameFormat::Sync0;
+    out[1] = AccFrameFormat::Sync1;
+    writeU16(out + 2, frame.sequence);
+    writeU32(out + 4, frame.deviceTimeUs);
+    writeFloat(out + 8, frame.x);
+    writeFloat(out + 12, frame.y);
+    writeFloat(out + 16, frame.z);
+    writeU16(out + 20, accCrc16(out + 2, 18));
+}
+
+AccFrameParser::AccFrameParser()
+{
+    // Zapas na kilka ramek, żeby typowe porcje z portu nie realokowały bufora
+    m_buffer.reserve(AccFrameFormat::FrameSize * 64);
+}
+
+void AccFrameParser::reset()
+{
+    m_buffer.clear();
+    m_stats = Stats();
+    m_haveSequence = false;
+}
+
+bool AccFrameParser::tryDecode(const std::uint8_t* data, AccFrame& frame)
+{
+    if (data[0] != AccFrameFormat::Sync0 || data[1] != AccFrameFormat::Sync1) {
+        ++m_stats.skippedBytes;
+        return false;
+    }
+
+    if (accCrc16(data + 2, 18) != readU16(data + 20)) {
+        // Fałszywy znacznik synchronizacji albo uszkodzona ramka – szukamy dalej od kolejnego bajtu
+        ++m_stats.crcErrors;
+        ++m_stats.skippedBytes;
+        return false;
+    }
+
+    frame.sequence = readU16(data + 2);
+    frame.deviceTimeUs = readU32(data + 4);
+    frame.x = readFloat(data + 8);
+    frame.y = readFloat(data + 12);
+    frame.z = readFloat(data + 16);
+
+    // Luka w numeracji oznacza ramki utracone po stronie łącza
+    if (m_haveSequence)
+        m_stats.lostFrames += static_cast<std::uint16_t>(frame.sequence - m_lastSequence - 1);
+    m_lastSequence = frame.sequence;
+    m_haveSequence = true;
+    ++m_stats.frames;
+    return true;
+}
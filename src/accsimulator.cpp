@@ -1,54 +1,132 @@
 #include "accsimulator.hpp"
-#include <QRandomGenerator>
+#include "pipelinestats.hpp"
+#include <algorithm>
+#include <cmath>
+
 AccSimulator::AccSimulator(QObject *parent)
-    : QObject(parent)
+    : SampleSource(parent)
 {
-    // Tworzenie obiektu QTimer, który będzie odpowiedzialny za generowanie danych
-    timer = new QTimer(this);
-
-    // Po każdym upływie czasu (timeout) wywołana zostanie funkcja generateData
-    connect(timer, &QTimer::timeout, this, &AccSimulator::generateData);
 }
 
-// Funkcja uruchamiająca symulator
+// Funkcja uruchamiająca symulator (siatka czasu i model od początku przy najbliższym poll())
 void AccSimulator::start()
 {
-    if (!running) {
-        // Rozpoczęcie generowania danych co 50ms (20Hz)
-        timer->start(50);
-        running = true; // Ustawienie flagi, że symulator działa
+    if (!running.exchange(true)) {
+        reseed = true;
+        restart = true;
     }
 }
 
 // Funkcja zatrzymująca symulator
 void AccSimulator::stop()
 {
-    if (running) {
-        // Zatrzymanie timera, który generuje dane
-        timer->stop();
-        running = false; // Ustawienie flagi, że symulator nie działa
-    }
+    running = false;
 }
 
 // Funkcja sprawdzająca, czy symulator jest uruchomiony
 bool AccSimulator::isRunning() const
 {
-    return running; // Zwrócenie stanu symulatora (czy jest uruchomiony)
+    return running.load(); // Zwrócenie stanu symulatora (czy jest uruchomiony)
+}
+
+void AccSimulator::setSampleRate(double hz)
+{
+    rate.store(std::clamp(hz, 0.1, MaxSampleRate));
+    restart = true;
+}
+
+double AccSimulator::sampleRate() const
+{
+    return rate.load();
+}
+
+void AccSimulator::setSeed(quint64 seed)
+{
+    seedValue.store(seed);
+    reseed = true;
+}
+
+quint64 AccSimulator::seed() const
+{
+    return seedValue.load();
+}
+
+quint64 AccSimulator::droppedSamples() const
+{
+    return dropped.load(std::memory_order_relaxed);
 }
 
-// Funkcja generująca losową wartość z zakresu [min, max]
-double AccSimulator::randomInRange(double min, double max) {
-    return min + QRandomGenerator::global()->generateDouble() * (max - min);
+// Przejęcie zmian zgłoszonych z innych wątków
+void AccSimulator::applyRequests(std::int64_t anchor)
+{
+    if (reseed.exchange(false))
+        model.reset(seedValue.load());
+    if (restart.exchange(false) || !anchored) {
+        activeRate = rate.load();
+        startTime = anchor;
+        emittedSamples = 0;
+        anchored = true;
+    }
 }
 
-// Funkcja wywoływana co 50ms (timer timeout), generująca dane dla trzech osi (x, y, z)
-void AccSimulator::generateData()
+// Kolejne próbki modelu na siatce czasu startTime + n * okres
+void AccSimulator::fill(AccSampleBlock& block)
 {
-    // Generowanie losowych danych dla każdej z osi w zakresie [-2.0, 2.0]
-    double x = randomInRange(-2.0, 2.0);
-    double y = randomInRange(-2.0, 2.0);
-    double z = randomInRange(-2.0, 2.0);
+    const double periodNs = 1e9 / activeRate;
+    const double dt = 1.0 / activeRate;
+    for (AccSample &sample : block) {
+        sample.timestamp = startTime + static_cast<std::int64_t>(emittedSamples * periodNs);
+        model.step(dt, sample.x, sample.y, sample.z);
+        ++emittedSamples;
+    }
+}
+
+// Przesunięcie modelu i siatki czasu o count próbek bez zapisywania wyników
+void AccSimulator::skip(qint64 count)
+{
+    const double dt = 1.0 / activeRate;
+    double x, y, z;
+    for (qint64 i = 0; i < count; ++i)
+        model.step(dt, x, y, z);
+    emittedSamples += count;
+}
+
+AccSampleBlock AccSimulator::generate(qint64 count)
+{
+    applyRequests(0);
+    AccSampleBlock block(static_cast<qsizetype>(std::max<qint64>(count, 0)));
+    fill(block);
+    return block;
+}
+
+// Funkcja generująca blok danych dla trzech osi (x, y, z).
+// Liczba próbek wynika z czasu, który upłynął od startu, więc średnia częstotliwość
+// nie zależy od regularności odpytywania.
+AccSampleBlock AccSimulator::poll(std::int64_t now)
+{
+    if (!running.load())
+        return {};
+
+    // Start albo zmiana częstotliwości w trakcie pracy – nowa siatka czasu liczona od bieżącej chwili
+    applyRequests(now);
+
+    const double periodNs = 1e9 / activeRate;
+    qint64 due = static_cast<qint64>(std::floor((now - startTime) / periodNs)) + 1 - emittedSamples;
+    if (due <= 0)
+        return {};
+
+    // Zbyt duża zaległość (np. przeciążona pula wątków) – pomijamy najstarsze próbki;
+    // model jest przesuwany bez zapisu, żeby przebieg nie zależał od momentu odpytania
+    const qint64 maxBacklog = std::max<qint64>(1, static_cast<qint64>(activeRate * maxBacklogSeconds));
+    if (due > maxBacklog) {
+        dropped.fetch_add(static_cast<quint64>(due - maxBacklog), std::memory_order_relaxed);
+        PipelineStats::addDropped(PipelineStats::Stage::Source, due - maxBacklog);
+        skip(due - maxBacklog);
+        due = maxBacklog;
+    }
 
-    // Emitowanie nowo wygenerowanych danych (sygnał do innych komponentów)
-    emit newData(x, y, z);
+    PipelineStats::ScopedTimer stats(PipelineStats::Stage::Source, due);
+    AccSampleBlock block(static_cast<qsizetype>(due));
+    fill(block);
+    return block;
 }
@@ -1,71 +1,404 @@
 #include "chartwindow.hpp"
 #include "ui_chartwindow.h"
+#include "pipelinestats.hpp"
+#include <algorithm>
+#include <cmath>
 
-ChartWindow::ChartWindow(QWidget *parent)
+ChartWindow::ChartWindow(QWidget *parent, TelemetryStore *telemetryStore, bool deferred)
     : QWidget(parent), ui(new Ui::ChartWindow)
+    , store(telemetryStore ? telemetryStore : TelemetryStore::instance())
 {
     ui->setupUi(this);
     QVBoxLayout *layout = new QVBoxLayout(this);
-    QString labels[3] = {"X to t", "Y to t", "Z to t"};
 
-    for (int i = 0; i < 3; ++i) {
-        series[i] = new QLineSeries();
-        chartViews[i] = new QChartView(new QChart(), this);
-        setupChart(i, labels[i]);
-        layout->addWidget(chartViews[i]);
+    // Wybór długości okna – od kilkunastu sekund do całego lotu
+    windowCombo = new QComboBox(this);
+    windowCombo->addItem("15 s", 15.0);
+    windowCombo->addItem("1 min", 60.0);
+    windowCombo->addItem("10 min", 600.0);
+    windowCombo->addItem("1 h", 3600.0);
+    windowCombo->addItem("All", 0.0);
+    connect(windowCombo, &QComboBox::currentIndexChanged, this, &ChartWindow::setWindowLength);
+
+    // Wybór sposobu rysowania – bez GPU lżejszy jest wykres rastrowy
+    rendererCombo = new QComboBox(this);
+    rendererCombo->addItem("QtCharts");
+    rendererCombo->addItem("Raster");
+    connect(rendererCombo, &QComboBox::currentIndexChanged, this, [this](int index) {
+        setRenderer(index == 1 ? Renderer::Raster : Renderer::Charts);
+    });
+
+    QHBoxLayout *controls = new QHBoxLayout();
+    controls->addWidget(new QLabel("Window:", this));
+    controls->addWidget(windowCombo);
+    controls->addWidget(new QLabel("Renderer:", this));
+    controls->addWidget(rendererCombo);
+    controls->addStretch();
+    layout->addLayout(controls);
+
+    grid = new QGridLayout();
+    layout->addLayout(grid, 1);
+
+    // Serie już zapisane w magazynie – wykresy od razu z pełną historią (albo kolejno w buildStep())
+    const QList<int> ids = store->seriesIds();
+    if (deferred) {
+        pendingStreams.assign(ids.cbegin(), ids.cend());
+    } else {
+        for (int id : ids)
+            addStream(id, store->seriesName(id));
     }
+    connect(store, &TelemetryStore::seriesAdded, this, &ChartWindow::addStream);
+    connect(store, &TelemetryStore::seriesRemoved, this, &ChartWindow::removeStream);
+    connect(store, &TelemetryStore::seriesCleared, this, &ChartWindow::resetStream);
+    connect(store, &TelemetryStore::appended, this, &ChartWindow::markDirty);
+
+    // Wykresy są przerysowywane w rytmie wyświetlania, a nie przy każdej próbce
+    refreshTimer = new QTimer(this);
+    connect(refreshTimer, &QTimer::timeout, this, &ChartWindow::refresh);
+    refreshTimer->setInterval(refreshIntervalMs);  // Takt działa tylko przy widocznym oknie (showEvent/hideEvent)
 }
 
 ChartWindow::~ChartWindow() {
     delete ui;
 }
 
-void ChartWindow::setupChart(int index, const QString &title)
+bool ChartWindow::buildStep()
+{
+    if (pendingStreams.empty())
+        return false;
+    const int id = pendingStreams.front();
+    pendingStreams.erase(pendingStreams.begin());
+    if (!findPlot(id)) {
+        addStream(id, store->seriesName(id));
+        // Pierwsze renderowanie samej komórki: czcionki i układ sceny QtCharts, bez reszty siatki
+        plots.back()->cell->grab();
+    }
+    return !pendingStreams.empty();
+}
+
+void ChartWindow::addStream(int streamId, const QString &name)
 {
-    QChart *chart = chartViews[index]->chart();
-    chart->legend()->hide();
-    chart->setTitle(title);
-    chart->addSeries(series[index]);
+    if (findPlot(streamId))
+        return;
+
+    static const char *axisNames[3] = {"X", "Y", "Z"};
+    auto plot = std::make_unique<StreamPlot>();
+    plot->id = streamId;
+    plot->cell = new QStackedWidget(this);
+    plot->view = new QChartView(new QChart(), plot->cell);
+    QChart *chart = plot->view->chart();
+    chart->setTitle(name);
+
+    plot->axisX = new QValueAxis();
+    plot->axisX->setRange(0, 15.0);
+    plot->axisX->setLabelFormat("%.1f");
+    plot->axisX->setTitleText("Time (s)");
+
+    plot->axisY = new QValueAxis();
+    plot->axisY->setRange(-2.0, 2.0);
+    plot->axisY->setTitleText("Value");
+
+    chart->addAxis(plot->axisX, Qt::AlignBottom);
+    chart->addAxis(plot->axisY, Qt::AlignLeft);
+
+    // Cień przerw pod przebiegami: górna łamana ma prostokąty nad przerwami, a poza nimi leży na dolnej
+    plot->gapArea = new QAreaSeries();
+    plot->gapUpper = new QLineSeries(plot->gapArea);
+    plot->gapLower = new QLineSeries(plot->gapArea);
+    plot->gapArea->setUpperSeries(plot->gapUpper);
+    plot->gapArea->setLowerSeries(plot->gapLower);
+    plot->gapArea->setName("Gap");
+    plot->gapArea->setColor(QColor(0, 0, 0, 24));
+    plot->gapArea->setBorderColor(Qt::transparent);
+    chart->addSeries(plot->gapArea);
+    plot->gapArea->attachAxis(plot->axisX);
+    plot->gapArea->attachAxis(plot->axisY);
+    for (QLegendMarker *marker : chart->legend()->markers(plot->gapArea))
+        marker->setVisible(false);
+    for (int i = 0; i < 3; ++i) {
+        plot->series[i] = new QLineSeries();
+        plot->series[i]->setName(axisNames[i]);
+        chart->addSeries(plot->series[i]);
+        plot->series[i]->attachAxis(plot->axisX);
+        plot->series[i]->attachAxis(plot->axisY);
+    }
+    plot->view->setRenderHint(QPainter::Antialiasing);
+
+    plot->raster = new RasterStripChart(plot->cell);
+    plot->raster->setTitle(name);
+    plot->raster->setTimeWindow(windowSeconds);
+    StreamPlot *raw = plot.get();
+    connect(plot->raster, &RasterStripChart::rebuildRequested, this, [this, raw]() {
+        if (activeRenderer == Renderer::Raster)
+            rebuildRaster(*raw);
+    });
 
-    axisX[index] = new QValueAxis();
-    axisX[index]->setRange(0, 15.0);
-    axisX[index]->setLabelFormat("%.1f");
-    axisX[index]->setTitleText("Time (s)");
+    plot->cell->addWidget(plot->view);
+    plot->cell->addWidget(plot->raster);
+    plot->cell->setCurrentWidget(activeRenderer == Renderer::Raster
+                                     ? static_cast<QWidget*>(plot->raster) : plot->view);
 
-    axisY[index] = new QValueAxis();
-    axisY[index]->setRange(-2.0, 2.0);
-    axisY[index]->setTitleText("Value");
+    // Obserwacja rysowania – pomiar opóźnienia od próbki do ekranu (dla pierwszego wykresu)
+    plot->view->viewport()->installEventFilter(this);
+    plot->raster->installEventFilter(this);
 
-    chart->addAxis(axisX[index], Qt::AlignBottom);
-    chart->addAxis(axisY[index], Qt::AlignLeft);
-    series[index]->attachAxis(axisX[index]);
-    series[index]->attachAxis(axisY[index]);
+    // Historia jest już w magazynie – pierwsze odświeżenie pokaże ją w całości
+    plot->lastTimestamp = store->lastTimestamp(streamId);
+    plot->dirty = true;
+    plots.push_back(std::move(plot));
+    relayout();
+}
 
-    chartViews[index]->setRenderHint(QPainter::Antialiasing);
+void ChartWindow::removeStream(int streamId)
+{
+    pendingStreams.erase(std::remove(pendingStreams.begin(), pendingStreams.end(), streamId), pendingStreams.end());
+    const auto it = std::find_if(plots.begin(), plots.end(),
+                                 [streamId](const std::unique_ptr<StreamPlot> &plot) { return plot->id == streamId; });
+    if (it == plots.end())
+        return;
+    delete (*it)->cell;
+    plots.erase(it);
+    relayout();
+}
+
+ChartWindow::StreamPlot* ChartWindow::findPlot(int streamId)
+{
+    for (const std::unique_ptr<StreamPlot> &plot : plots) {
+        if (plot->id == streamId)
+            return plot.get();
+    }
+    return nullptr;
+}
+
+// Układ siatki zbliżony do kwadratu: 1 strumień – cały obszar, 16 – 4 x 4
+void ChartWindow::relayout()
+{
+    const int count = static_cast<int>(plots.size());
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    for (int i = 0; i < count; ++i) {
+        grid->removeWidget(plots[i]->cell);
+        grid->addWidget(plots[i]->cell, i / columns, i % columns);
+        plots[i]->view->chart()->legend()->setVisible(count <= 4);
+    }
 }
 
-float ChartWindow::getCurrentTime() const {
-    return sampleCount * 0.05f;
+// Subskrypcja magazynu: tylko odnotowanie zmiany, bez odrysowywania
+void ChartWindow::markDirty(int streamId, qint64 lastTimestamp)
+{
+    if (StreamPlot *plot = findPlot(streamId)) {
+        plot->lastTimestamp = lastTimestamp;
+        plot->dirty = true;
+    }
 }
 
-void ChartWindow::addData(float x, float y, float z)
+// Dane serii wyczyszczone (np. przejście na odtwarzanie) – wykres od nowa
+void ChartWindow::resetStream(int streamId)
 {
-    const float time = getCurrentTime();
+    if (StreamPlot *plot = findPlot(streamId)) {
+        plot->lastTimestamp = 0;
+        plot->rasterTimestamp = 0;
+        plot->raster->setTimeWindow(windowSeconds);
+        for (QLineSeries *series : plot->series)
+            series->clear();
+        plot->gapUpper->clear();
+        plot->gapLower->clear();
+        plot->dirty = true;
+    }
+}
 
-    series[0]->append(time, x);
-    series[1]->append(time, y);
-    series[2]->append(time, z);
-    ++sampleCount;
+void ChartWindow::setWindowLength(int index)
+{
+    windowSeconds = windowCombo->itemData(index).toDouble();
+    for (const std::unique_ptr<StreamPlot> &plot : plots) {
+        plot->dirty = true;
+        plot->raster->setTimeWindow(windowSeconds);
+        if (activeRenderer == Renderer::Raster)
+            rebuildRaster(*plot);
+    }
+    refresh();
+}
 
+// Przełączenie w locie; historia jest w magazynie, więc nowy widok od razu pokazuje całe okno
+void ChartWindow::setRenderer(Renderer renderer)
+{
+    if (renderer == activeRenderer)
+        return;
+    activeRenderer = renderer;
+    rendererCombo->setCurrentIndex(renderer == Renderer::Raster ? 1 : 0);
+    for (const std::unique_ptr<StreamPlot> &plot : plots) {
+        if (renderer == Renderer::Raster) {
+            plot->cell->setCurrentWidget(plot->raster);
+            rebuildRaster(*plot);
+        } else {
+            plot->cell->setCurrentWidget(plot->view);
+            plot->dirty = true;
+        }
+    }
+}
+
+bool ChartWindow::visibleRange(int streamId, double &start, double &end) const
+{
+    double oldest = 0.0;
+    if (!store->overviewRange(streamId, oldest, end))
+        return false;
+    start = windowSeconds > 0.0 ? std::max(end - windowSeconds, oldest) : oldest;
+    return true;
+}
+
+// Odtworzenie obrazu rastrowego z magazynu – po przełączeniu, zmianie okna lub rozmiaru
+void ChartWindow::rebuildRaster(StreamPlot &plot)
+{
+    double start = 0.0;
+    double end = 0.0;
+    if (!visibleRange(plot.id, start, end))
+        return;
+    const std::size_t columns = static_cast<std::size_t>(std::max(1, plot.raster->columnCount()));
+    for (int i = 0; i < 3; ++i)
+        store->overview(plot.id, i, start, end, columns, rasterBuckets[i]);
+    collectGaps(plot.id, start, end);
+    plot.raster->rebuild(windowSeconds > 0.0 ? end - windowSeconds : start, end, rasterBuckets, gapSpans);
+    plot.rasterTimestamp = store->lastTimestamp(plot.id);
+}
+
+// Odświeżenie wykresów: jedno replace() na serię i jedna zmiana zakresu osi na wykres na takt.
+// Liczba punktów jest ograniczona szerokością wykresu, niezależnie od długości okna,
+// a wykresy bez nowych danych nie są dotykane.
+void ChartWindow::refresh()
+{
+    // Okno przygotowane zawczasu (ukryte) nie odświeża wykresów – dane czekają w magazynie
+    if (!isVisible())
+        return;
+    bool refreshed = false;
+    for (const std::unique_ptr<StreamPlot> &plot : plots) {
+        if (!plot->dirty)
+            continue;
+        if (!refreshed) {
+            ++refreshesSincePaint;
+            refreshed = true;
+        }
+        refreshPlot(*plot);
+    }
+}
+
+void ChartWindow::refreshPlot(StreamPlot &plot)
+{
+    plot.dirty = false;
+    double start = 0.0;
+    double end = 0.0;
+    if (!visibleRange(plot.id, start, end))
+        return;
+    PipelineStats::ScopedTimer stats(PipelineStats::Stage::ChartRefresh);
+    if (&plot == plots.front().get())
+        shownTimestamp = plot.lastTimestamp;
+
+    // Raster: w przesuwanym oknie tylko próbki nowsze od ostatnio narysowanych, dla całej historii – przebudowa
+    if (activeRenderer == Renderer::Raster) {
+        if (windowSeconds > 0.0 && plot.rasterTimestamp != 0
+            && store->toSeconds(plot.rasterTimestamp) >= end - windowSeconds) {
+            store->samples(plot.id, plot.rasterTimestamp + 1, plot.lastTimestamp, newSamples);
+            store->gaps(plot.id, plot.rasterTimestamp + 1, plot.lastTimestamp, gaps);
+            std::size_t nextGap = 0;
+            for (const AccSample &sample : newSamples) {
+                while (nextGap < gaps.size() && gaps[nextGap].end < sample.timestamp)
+                    ++nextGap;
+                const bool afterGap = nextGap < gaps.size() && gaps[nextGap].end == sample.timestamp;
+                plot.raster->append(store->toSeconds(sample.timestamp), sample.x, sample.y, sample.z, afterGap);
+            }
+            if (!newSamples.empty())
+                plot.rasterTimestamp = newSamples.back().timestamp;
+            plot.raster->flush();
+        } else {
+            rebuildRaster(plot);
+        }
+        return;
+    }
+
+    const int pixels = std::max(1, static_cast<int>(plot.view->chart()->plotArea().width()));
     for (int i = 0; i < 3; ++i) {
-        if (series[i]->count() > maxSamples)
-            series[i]->remove(0);
+        store->overview(plot.id, i, start, end, static_cast<std::size_t>(pixels), buckets);
 
-        // Przesuwaj zakres osi X zgodnie z czasem
-        axisX[i]->setRange(time - 15.0f, time);
+        // Kubełek z jedną próbką daje jeden punkt, zagregowany – parę min/max
+        points.clear();
+        points.reserve(static_cast<qsizetype>(buckets.size() * 2));
+        for (const MinMaxPyramid::Bucket &bucket : buckets) {
+            if (bucket.t0 == bucket.t1) {
+                points.append(QPointF(bucket.t0, bucket.min));
+            } else {
+                points.append(QPointF(bucket.t0, bucket.min));
+                points.append(QPointF(bucket.t1, bucket.max));
+            }
+        }
+        plot.series[i]->replace(points);
     }
+
+    // Przesuwaj zakres osi X zgodnie z czasem
+    plot.axisX->setRange(windowSeconds > 0.0 ? end - windowSeconds : start, end);
+    updateGaps(plot, start, end);
 }
 
-void ChartWindow::updateData(double x, double y, double z) {
-    addData(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+void ChartWindow::collectGaps(int streamId, double start, double end)
+{
+    gapSpans.clear();
+    store->gaps(streamId, store->fromSeconds(start), store->fromSeconds(end), gaps);
+    for (const TelemetryStore::Gap &gap : gaps)
+        gapSpans.emplace_back(store->toSeconds(gap.start), store->toSeconds(gap.end));
+}
+
+// Cień przerw w widocznym przedziale; bez przerw seria nie jest dotykana
+void ChartWindow::updateGaps(StreamPlot &plot, double start, double end)
+{
+    collectGaps(plot.id, start, end);
+    if (gapSpans.empty() && plot.gapUpper->count() == 0)
+        return;
+
+    const double low = plot.axisY->min();
+    const double high = plot.axisY->max();
+    points.clear();
+    for (const std::pair<double, double> &span : gapSpans) {
+        const double from = std::max(span.first, start);
+        const double to = std::min(span.second, end);
+        points.append(QPointF(from, low));
+        points.append(QPointF(from, high));
+        points.append(QPointF(to, high));
+        points.append(QPointF(to, low));
+    }
+    plot.gapUpper->replace(points);
+    points.clear();
+    if (!gapSpans.empty()) {
+        points.append(QPointF(start, low));
+        points.append(QPointF(end, low));
+    }
+    plot.gapLower->replace(points);
+}
+
+// Pierwsza klatka po pokazaniu okna od razu z aktualnymi danymi, bez czekania na takt odświeżania
+void ChartWindow::showEvent(QShowEvent *event)
+{
+    // Wykresy, których budowa w tle nie zdążyła się zakończyć
+    for (int id : pendingStreams)
+        addStream(id, store->seriesName(id));
+    pendingStreams.clear();
+    QWidget::showEvent(event);
+    refreshTimer->start();
+    refresh();
+}
+
+// Zamknięte okno jest tylko ukrywane – bez taktu odświeżania nie zajmuje czasu wątku GUI
+void ChartWindow::hideEvent(QHideEvent *event)
+{
+    refreshTimer->stop();
+    QWidget::hideEvent(event);
+}
+
+bool ChartWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Paint && !plots.empty() && shownTimestamp != 0
+        && (watched == plots.front()->view->viewport() || watched == plots.front()->raster)) {
+        // Kilka odświeżeń danych przed jednym rysowaniem = klatki połączone
+        PipelineStats::record(PipelineStats::Stage::ChartPaint, accTimestampNow() - shownTimestamp);
+        PipelineStats::addCoalesced(PipelineStats::Stage::ChartPaint, refreshesSincePaint - 1);
+        refreshesSincePaint = 0;
+        emit framePainted(shownTimestamp);
+    }
+    return QWidget::eventFilter(watched, event);
 }
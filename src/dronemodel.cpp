@@ -0,0 +1,172 @@
+#include "dronemodel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double Gravity = 9.80665;
+constexpr double Pi = 3.14159265358979323846;
+
+std::uint64_t rotl(std::uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+// SplitMix64 – rozprowadzenie jednego ziarna na cały stan xoshiro
+std::uint64_t splitMix64(std::uint64_t& state)
+{
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+}
+
+Xoshiro256::Xoshiro256(std::uint64_t seedValue)
+{
+    seed(seedValue);
+}
+
+void Xoshiro256::seed(std::uint64_t seedValue)
+{
+    for (std::uint64_t& word : s)
+        word = splitMix64(seedValue);
+    hasSpare = false;
+}
+
+std::uint64_t Xoshiro256::next()
+{
+    const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const std::uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+double Xoshiro256::uniform()
+{
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+}
+
+double Xoshiro256::normal()
+{
+    if (hasSpare) {
+        hasSpare = false;
+        return spare;
+    }
+    double u, v, r;
+    do {
+        u = 2.0 * uniform() - 1.0;
+        v = 2.0 * uniform() - 1.0;
+        r = u * u + v * v;
+    } while (r >= 1.0 || r == 0.0);
+    const double scale = std::sqrt(-2.0 * std::log(r) / r);
+    spare = v * scale;
+    hasSpare = true;
+    return u * scale;
+}
+
+DroneModel::DroneModel(std::uint64_t seed, const DroneParameters& parameters)
+    : p(parameters)
+{
+    reset(seed);
+}
+
+void DroneModel::reset(std::uint64_t seed)
+{
+    rng.seed(seed);
+    roll = pitch = yaw = 0.0;
+    rollTarget = pitchTarget = yawRate = 0.0;
+    altitude = altitudeTarget = 10.0;
+    for (int i = 0; i < 3; ++i) {
+        velocity[i] = 0.0;
+        wind[i] = 0.0;
+        bias[i] = p.biasG * rng.normal();
+    }
+    for (int i = 0; i < 4; ++i) {
+        motorPhase[i] = 2.0 * Pi * rng.uniform();
+        motorDetune[i] = 0.02 * rng.normal();
+    }
+    untilManeuver = 0.0;
+}
+
+void DroneModel::step(double dt, double& ax, double& ay, double& az)
+{
+    // Nowy manewr: zadane przechylenia, obrót wokół osi pionowej i wysokość
+    untilManeuver -= dt;
+    if (untilManeuver <= 0.0) {
+        const double maxTilt = p.maneuverDeg * Pi / 180.0;
+        rollTarget = maxTilt * (2.0 * rng.uniform() - 1.0);
+        pitchTarget = maxTilt * (2.0 * rng.uniform() - 1.0);
+        yawRate = 0.3 * rng.normal();
+        altitudeTarget = std::clamp(altitudeTarget + 2.0 * rng.normal(), 2.0, 50.0);
+        untilManeuver = p.maneuverSeconds * (0.5 + rng.uniform());
+    }
+
+    // Orientacja nadąża za zadaną z opóźnieniem pierwszego rzędu (stała czasowa 0,3 s)
+    const double attitudeGain = std::min(1.0, dt / 0.3);
+    roll += (rollTarget - roll) * attitudeGain;
+    pitch += (pitchTarget - pitch) * attitudeGain;
+    yaw += yawRate * dt;
+
+    // Wiatr: proces Ornsteina-Uhlenbecka o czasie korelacji 2 s
+    const double theta = 0.5;
+    const double windNoise = p.gustMs * std::sqrt(2.0 * theta * dt);
+    for (double& w : wind)
+        w += -theta * w * dt + windNoise * rng.normal();
+
+    // Regulator wysokości PD; ciąg kompensuje przechylenie, ograniczony do 2 g
+    const double cr = std::cos(roll), sr = std::sin(roll);
+    const double cp = std::cos(pitch), sp = std::sin(pitch);
+    const double cy = std::cos(yaw), sy = std::sin(yaw);
+    const double verticalCommand = 1.5 * (altitudeTarget - altitude) - 2.0 * velocity[2];
+    const double thrust = std::clamp((Gravity + verticalCommand) / std::max(cr * cp, 0.5), 0.0, 2.0 * Gravity);
+
+    // Macierz obrotu z układu drona do układu ziemi (Z-Y-X); ciąg działa wzdłuż osi Z drona
+    const double r[3][3] = {
+        {cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+        {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+        {-sp,     cp * sr,                cp * cr}
+    };
+
+    // Siła właściwa w układzie ziemi: ciąg i opór powietrza (przyspieszenie minus grawitacja)
+    double specific[3];
+    for (int i = 0; i < 3; ++i)
+        specific[i] = r[i][2] * thrust - p.dragCoefficient * (velocity[i] - wind[i]);
+    velocity[0] += specific[0] * dt;
+    velocity[1] += specific[1] * dt;
+    velocity[2] += (specific[2] - Gravity) * dt;
+    altitude += velocity[2] * dt;
+
+    // Do układu drona: R^T * siła właściwa, w jednostkach g
+    double body[3];
+    for (int i = 0; i < 3; ++i)
+        body[i] = (r[0][i] * specific[0] + r[1][i] * specific[1] + r[2][i] * specific[2]) / Gravity;
+
+    // Drgania silników: obroty rosną z pierwiastkiem ciągu; harmoniczne powyżej ~0,45 częstotliwości
+    // próbkowania są tłumione jak przez filtr antyaliasingowy czujnika
+    const double rotorHz = p.rotorHz * std::sqrt(thrust / Gravity);
+    const double cutoffHz = 0.45 / dt;
+    double vibration[4];
+    for (int i = 0; i < 4; ++i) {
+        motorPhase[i] = std::fmod(motorPhase[i] + 2.0 * Pi * rotorHz * (1.0 + motorDetune[i]) * dt, 2.0 * Pi);
+        vibration[i] = std::sin(motorPhase[i]);
+    }
+    const auto passband = [cutoffHz](double hz) {
+        const double ratio = hz / cutoffHz;
+        return 1.0 / (1.0 + ratio * ratio * ratio * ratio);
+    };
+    const double first = p.vibrationG * passband(rotorHz);
+    const double second = 0.4 * p.vibrationG * passband(2.0 * rotorHz);
+    body[0] += first * 0.5 * (vibration[0] - vibration[2]);
+    body[1] += first * 0.5 * (vibration[1] - vibration[3]);
+    body[2] += second * 0.25 * (std::sin(2.0 * motorPhase[0]) + std::sin(2.0 * motorPhase[1])
+                                + std::sin(2.0 * motorPhase[2]) + std::sin(2.0 * motorPhase[3]));
+
+    ax = body[0] + bias[0] + p.noiseG * rng.normal();
+    ay = body[1] + bias[1] + p.noiseG * rng.normal();
+    az = body[2] + bias[2] + p.noiseG * rng.normal();
+}
@@ -0,0 +1,412 @@
+#include "dspfilters.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define DSP_HAVE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DSP_HAVE_SSE2 1
+#endif
+
+namespace dsp {
+
+bool Filter::hasSimdKernel() const
+{
+#if defined(DSP_HAVE_AVX) || defined(DSP_HAVE_SSE2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* simdInstructionSet()
+{
+#if defined(DSP_HAVE_AVX) && defined(__FMA__)
+    return "AVX+FMA";
+#elif defined(DSP_HAVE_AVX)
+    return "AVX";
+#elif defined(DSP_HAVE_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+namespace {
+
+constexpr double Pi = 3.14159265358979323846;
+
+#if defined(DSP_HAVE_AVX)
+inline __m256d fmadd(__m256d a, __m256d b, __m256d c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+#endif
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Biquad
+
+Biquad::Biquad(Type type, double sampleRate, double cutoffHz, double q)
+    : m_type(type)
+    , m_cutoff(cutoffHz)
+{
+    // Współczynniki wg "Audio EQ Cookbook" (R. Bristow-Johnson), znormalizowane przez a0
+    const double w0 = 2.0 * Pi * std::min(cutoffHz, 0.49 * sampleRate) / sampleRate;
+    const double cosW = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    if (type == Type::LowPass) {
+        m_b0 = (1.0 - cosW) / 2.0 / a0;
+        m_b1 = (1.0 - cosW) / a0;
+        m_b2 = m_b0;
+    } else {
+        m_b0 = (1.0 + cosW) / 2.0 / a0;
+        m_b1 = -(1.0 + cosW) / a0;
+        m_b2 = m_b0;
+    }
+    m_a1 = -2.0 * cosW / a0;
+    m_a2 = (1.0 - alpha) / a0;
+}
+
+void Biquad::process(SoaBlock& block)
+{
+    const std::size_t n = block.size();
+    double* ch[3] = {block.x.data(), block.y.data(), block.z.data()};
+
+#if defined(DSP_HAVE_AVX)
+    if (m_simd) {
+        // Trzy osie w jednym rejestrze 256-bitowym; czwarty pas jest nieużywany
+        const __m256d b0 = _mm256_set1_pd(m_b0), b1 = _mm256_set1_pd(m_b1), b2 = _mm256_set1_pd(m_b2);
+        const __m256d na1 = _mm256_set1_pd(-m_a1), na2 = _mm256_set1_pd(-m_a2);
+        __m256d s1 = _mm256_load_pd(m_s1);
+        __m256d s2 = _mm256_load_pd(m_s2);
+        alignas(32) double out[4];
+        for (std::size_t i = 0; i < n; ++i) {
+            const __m256d in = _mm256_set_pd(0.0, ch[2][i], ch[1][i], ch[0][i]);
+            const __m256d y = fmadd(b0, in, s1);
+            s1 = fmadd(na1, y, fmadd(b1, in, s2));
+            s2 = fmadd(na2, y, _mm256_mul_pd(b2, in));
+            _mm256_store_pd(out, y);
+            ch[0][i] = out[0];
+            ch[1][i] = out[1];
+            ch[2][i] = out[2];
+        }
+        _mm256_store_pd(m_s1, s1);
+        _mm256_store_pd(m_s2, s2);
+        return;
+    }
+#elif defined(DSP_HAVE_SSE2)
+    if (m_simd) {
+        // Osie X i Y w jednym rejestrze 128-bitowym, Z liczona skalarnie w tej samej pętli
+        const __m128d b0 = _mm_set1_pd(m_b0), b1 = _mm_set1_pd(m_b1), b2 = _mm_set1_pd(m_b2);
+        const __m128d a1 = _mm_set1_pd(m_a1), a2 = _mm_set1_pd(m_a2);
+        __m128d s1 = _mm_load_pd(m_s1);
+        __m128d s2 = _mm_load_pd(m_s2);
+        double zs1 = m_s1[2], zs2 = m_s2[2];
+        alignas(16) double out[2];
+        for (std::size_t i = 0; i < n; ++i) {
+            const __m128d in = _mm_set_pd(ch[1][i], ch[0][i]);
+            const __m128d y = _mm_add_pd(_mm_mul_pd(b0, in), s1);
+            s1 = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(b1, in), s2), _mm_mul_pd(a1, y));
+            s2 = _mm_sub_pd(_mm_mul_pd(b2, in), _mm_mul_pd(a2, y));
+            _mm_store_pd(out, y);
+            ch[0][i] = out[0];
+            ch[1][i] = out[1];
+
+            const double zin = ch[2][i];
+            const double zy = m_b0 * zin + zs1;
+            zs1 = m_b1 * zin - m_a1 * zy + zs2;
+            zs2 = m_b2 * zin - m_a2 * zy;
+            ch[2][i] = zy;
+        }
+        _mm_store_pd(m_s1, s1);
+        _mm_store_pd(m_s2, s2);
+        m_s1[2] = zs1;
+        m_s2[2] = zs2;
+        return;
+    }
+#endif
+
+    for (int c = 0; c < 3; ++c) {
+        double s1 = m_s1[c], s2 = m_s2[c];
+        double* data = ch[c];
+        for (std::size_t i = 0; i < n; ++i) {
+            const double in = data[i];
+            const double y = m_b0 * in + s1;
+            s1 = m_b1 * in - m_a1 * y + s2;
+            s2 = m_b2 * in - m_a2 * y;
+            data[i] = y;
+        }
+        m_s1[c] = s1;
+        m_s2[c] = s2;
+    }
+}
+
+void Biquad::reset()
+{
+    std::fill(std::begin(m_s1), std::end(m_s1), 0.0);
+    std::fill(std::begin(m_s2), std::end(m_s2), 0.0);
+}
+
+std::string Biquad::name() const
+{
+    char text[48];
+    std::snprintf(text, sizeof(text), "%s %g Hz", m_type == Type::LowPass ? "low-pass" : "high-pass", m_cutoff);
+    return text;
+}
+
+// ---------------------------------------------------------------------------
+// MovingAverage
+
+MovingAverage::MovingAverage(std::size_t length)
+    : m_length(std::max<std::size_t>(length, 1))
+{
+    for (std::vector<double>& history : m_history)
+        history.assign(m_length, 0.0);
+}
+
+// Suma bieżąca kosztuje jedno dodawanie i jedno odejmowanie na próbkę, a operacja
+// jest ograniczona przepustowością pamięci – jądro wektorowe niczego tu nie zyskuje
+void MovingAverage::process(SoaBlock& block)
+{
+    const std::size_t n = block.size();
+    double* ch[3] = {block.x.data(), block.y.data(), block.z.data()};
+
+    for (std::size_t i = 0; i < n; ++i) {
+        if (m_filled < m_length)
+            ++m_filled;
+        const double scale = 1.0 / static_cast<double>(m_filled);
+        for (int c = 0; c < 3; ++c) {
+            const double in = ch[c][i];
+            m_sum[c] += in - m_history[c][m_pos];
+            m_history[c][m_pos] = in;
+            ch[c][i] = m_sum[c] * scale;
+        }
+        if (++m_pos == m_length) {
+            m_pos = 0;
+            // Okresowe przeliczenie sumy od zera – błąd zaokrągleń nie narasta (O(1) zamortyzowane)
+            for (int c = 0; c < 3; ++c) {
+                double sum = 0.0;
+                for (double value : m_history[c])
+                    sum += value;
+                m_sum[c] = sum;
+            }
+        }
+    }
+}
+
+void MovingAverage::reset()
+{
+    for (std::vector<double>& history : m_history)
+        std::fill(history.begin(), history.end(), 0.0);
+    std::fill(std::begin(m_sum), std::end(m_sum), 0.0);
+    m_pos = 0;
+    m_filled = 0;
+}
+
+std::string MovingAverage::name() const
+{
+    return "moving average " + std::to_string(m_length);
+}
+
+// ---------------------------------------------------------------------------
+// Fir
+
+Fir::Fir(std::vector<double> taps)
+    : m_reversed(taps.rbegin(), taps.rend())
+{
+    if (m_reversed.empty())
+        m_reversed.push_back(1.0);
+    for (std::vector<double>& history : m_history)
+        history.assign(m_reversed.size() - 1, 0.0);
+}
+
+void Fir::process(SoaBlock& block)
+{
+    processChannel(block.x, m_history[0]);
+    processChannel(block.y, m_history[1]);
+    processChannel(block.z, m_history[2]);
+}
+
+void Fir::processChannel(std::vector<double>& data, std::vector<double>& history)
+{
+    const std::size_t n = data.size();
+    const std::size_t taps = m_reversed.size();
+    const std::size_t keep = taps - 1;
+
+    // Bufor ciągły: taps-1 próbek z poprzedniego bloku, a za nimi bieżący blok
+    m_scratch.resize(keep + n);
+    std::copy(history.begin(), history.end(), m_scratch.begin());
+    std::copy(data.begin(), data.end(), m_scratch.begin() + static_cast<std::ptrdiff_t>(keep));
+
+    const double* in = m_scratch.data();
+    const double* h = m_reversed.data();
+    double* out = data.data();
+    std::size_t i = 0;
+
+#if defined(DSP_HAVE_AVX)
+    if (m_simd) {
+        // Cztery kolejne próbki wyjściowe naraz
+        for (; i + 4 <= n; i += 4) {
+            __m256d acc = _mm256_setzero_pd();
+            for (std::size_t k = 0; k < taps; ++k)
+                acc = fmadd(_mm256_set1_pd(h[k]), _mm256_loadu_pd(in + i + k), acc);
+            _mm256_storeu_pd(out + i, acc);
+        }
+    }
+#elif defined(DSP_HAVE_SSE2)
+    if (m_simd) {
+        // Dwie kolejne próbki wyjściowe naraz
+        for (; i + 2 <= n; i += 2) {
+            __m128d acc = _mm_setzero_pd();
+            for (std::size_t k = 0; k < taps; ++k)
+                acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(h[k]), _mm_loadu_pd(in + i + k)));
+            _mm_storeu_pd(out + i, acc);
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        double acc = 0.0;
+        for (std::size_t k = 0; k < taps; ++k)
+            acc += h[k] * in[i + k];
+        out[i] = acc;
+    }
+
+    std::copy(m_scratch.end() - static_cast<std::ptrdiff_t>(keep), m_scratch.end(), history.begin());
+}
+
+void Fir::reset()
+{
+    for (std::vector<double>& history : m_history)
+        std::fill(history.begin(), history.end(), 0.0);
+}
+
+std::string Fir::name() const
+{
+    return "FIR " + std::to_string(m_reversed.size()) + " taps";
+}
+
+// ---------------------------------------------------------------------------
+// GravityRemoval
+
+GravityRemoval::GravityRemoval(double sampleRate, double cutoffHz)
+{
+    // Współczynnik jednobiegunowego filtra dolnoprzepustowego dla zadanej częstotliwości odcięcia
+    const double rc = 1.0 / (2.0 * Pi * cutoffHz);
+    const double dt = 1.0 / sampleRate;
+    m_alpha = dt / (rc + dt);
+}
+
+void GravityRemoval::process(SoaBlock& block)
+{
+    const std::size_t n = block.size();
+    if (n == 0)
+        return;
+    double* ch[3] = {block.x.data(), block.y.data(), block.z.data()};
+
+    // Estymata startuje od pierwszej próbki, żeby nie było długiego stanu przejściowego
+    if (!m_initialized) {
+        for (int c = 0; c < 3; ++c)
+            m_gravity[c] = ch[c][0];
+        m_initialized = true;
+    }
+
+#if defined(DSP_HAVE_AVX)
+    if (m_simd) {
+        const __m256d alpha = _mm256_set1_pd(m_alpha);
+        __m256d g = _mm256_load_pd(m_gravity);
+        alignas(32) double out[4];
+        for (std::size_t i = 0; i < n; ++i) {
+            const __m256d in = _mm256_set_pd(0.0, ch[2][i], ch[1][i], ch[0][i]);
+            g = fmadd(alpha, _mm256_sub_pd(in, g), g);
+            _mm256_store_pd(out, _mm256_sub_pd(in, g));
+            ch[0][i] = out[0];
+            ch[1][i] = out[1];
+            ch[2][i] = out[2];
+        }
+        _mm256_store_pd(m_gravity, g);
+        return;
+    }
+#elif defined(DSP_HAVE_SSE2)
+    if (m_simd) {
+        // Osie X i Y w jednym rejestrze 128-bitowym, Z liczona skalarnie w tej samej pętli
+        const __m128d alpha = _mm_set1_pd(m_alpha);
+        __m128d g = _mm_load_pd(m_gravity);
+        double gz = m_gravity[2];
+        alignas(16) double out[2];
+        for (std::size_t i = 0; i < n; ++i) {
+            const __m128d in = _mm_set_pd(ch[1][i], ch[0][i]);
+            g = _mm_add_pd(_mm_mul_pd(alpha, _mm_sub_pd(in, g)), g);
+            _mm_store_pd(out, _mm_sub_pd(in, g));
+            ch[0][i] = out[0];
+            ch[1][i] = out[1];
+
+            gz += m_alpha * (ch[2][i] - gz);
+            ch[2][i] -= gz;
+        }
+        _mm_store_pd(m_gravity, g);
+        m_gravity[2] = gz;
+        return;
+    }
+#endif
+
+    for (int c = 0; c < 3; ++c) {
+        double g = m_gravity[c];
+        double* data = ch[c];
+        for (std::size_t i = 0; i < n; ++i) {
+            g += m_alpha * (data[i] - g);
+            data[i] -= g;
+        }
+        m_gravity[c] = g;
+    }
+}
+
+void GravityRemoval::reset()
+{
+    m_initialized = false;
+    std::fill(std::begin(m_gravity), std::end(m_gravity), 0.0);
+}
+
+std::string GravityRemoval::name() const
+{
+    return "gravity removal";
+}
+
+// ---------------------------------------------------------------------------
+// FilterChain
+
+void FilterChain::add(std::unique_ptr<Filter> filter)
+{
+    m_filters.push_back(std::move(filter));
+}
+
+void FilterChain::process(SoaBlock& block)
+{
+    for (const std::unique_ptr<Filter>& filter : m_filters)
+        filter->process(block);
+}
+
+void FilterChain::reset()
+{
+    for (const std::unique_ptr<Filter>& filter : m_filters)
+        filter->reset();
+}
+
+void FilterChain::setSimdEnabled(bool enabled)
+{
+    for (const std::unique_ptr<Filter>& filter : m_filters)
+        filter->setSimdEnabled(enabled);
+}
+
+} // namespace dsp
@@ -0,0 +1,317 @@
+#include "eventdetector.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Kolejka dwustronna na buforze pierścieniowym o pojemności 2^n; rośnie przez podwojenie,
+// więc po rozgrzaniu okna nie alokuje pamięci
+template <typename T>
+class RingDeque
+{
+public:
+    bool empty() const { return m_size == 0; }
+    std::size_t size() const { return m_size; }
+    T& front() { return m_data[m_head]; }
+    T& back() { return m_data[(m_head + m_size - 1) & m_mask]; }
+    const T& operator[](std::size_t i) const { return m_data[(m_head + i) & m_mask]; }
+
+    void push_back(const T& value)
+    {
+        if (m_size == m_data.size())
+            grow();
+        m_data[(m_head + m_size) & m_mask] = value;
+        ++m_size;
+    }
+    void pop_front()
+    {
+        m_head = (m_head + 1) & m_mask;
+        --m_size;
+    }
+    void pop_back() { --m_size; }
+
+private:
+    void grow()
+    {
+        std::vector<T> data(std::max<std::size_t>(16, 2 * m_data.size()));
+        for (std::size_t i = 0; i < m_size; ++i)
+            data[i] = (*this)[i];
+        m_data.swap(data);
+        m_head = 0;
+        m_mask = m_data.size() - 1;
+    }
+
+    std::vector<T> m_data;
+    std::size_t m_head = 0;
+    std::size_t m_size = 0;
+    std::size_t m_mask = 0;
+};
+
+constexpr std::size_t RebuildSlack = 64;
+
+} // namespace
+
+// Okno czasowe (t - length, t] jednej wielkości; liczy tylko agregaty potrzebne regułom
+struct EventDetector::Window
+{
+    struct Entry
+    {
+        std::int64_t timestamp;
+        double value;
+        double x, y, z;
+    };
+    struct Extreme
+    {
+        std::int64_t timestamp;
+        double value;
+    };
+
+    Quantity quantity = Quantity::Magnitude;
+    std::int64_t length = 1;
+    bool sums = false;      ///< Średnia i RMS.
+    bool vector = false;    ///< RMS wektora przyspieszenia – sumy osi.
+    bool peak = false;
+    bool min = false;
+
+    RingDeque<Entry> entries;
+    RingDeque<Extreme> maxima;   ///< Malejąco: front – maksimum okna.
+    RingDeque<Extreme> minima;   ///< Rosnąco: front – minimum okna.
+    double sum = 0.0;
+    double sumSq = 0.0;          ///< Suma kwadratów wartości; dla modułu równa sumie x² + y² + z².
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumZ = 0.0;
+    std::size_t evicted = 0;     ///< Próbki usunięte od ostatniego przeliczenia sum.
+
+    void push(const AccSample& sample, double value)
+    {
+        const Entry entry{sample.timestamp, value, sample.x, sample.y, sample.z};
+        entries.push_back(entry);
+        if (sums)
+            accumulate(entry, 1.0);
+        if (peak) {
+            while (!maxima.empty() && maxima.back().value <= value)
+                maxima.pop_back();
+            maxima.push_back({sample.timestamp, value});
+        }
+        if (min) {
+            while (!minima.empty() && minima.back().value >= value)
+                minima.pop_back();
+            minima.push_back({sample.timestamp, value});
+        }
+
+        const std::int64_t oldest = sample.timestamp - length;
+        while (entries.size() > 1 && entries.front().timestamp <= oldest) {
+            if (sums)
+                accumulate(entries.front(), -1.0);
+            entries.pop_front();
+            ++evicted;
+        }
+        while (maxima.size() > 1 && maxima.front().timestamp <= oldest)
+            maxima.pop_front();
+        while (minima.size() > 1 && minima.front().timestamp <= oldest)
+            minima.pop_front();
+
+        // Odejmowanie od sum bieżących kumuluje błąd zaokrągleń – po wymianie całej
+        // zawartości okna sumy są liczone od nowa, co daje zamortyzowane O(1)
+        if (sums && evicted > entries.size() + RebuildSlack)
+            rebuild();
+    }
+
+    void accumulate(const Entry& entry, double sign)
+    {
+        sum += sign * entry.value;
+        sumSq += sign * entry.value * entry.value;
+        if (vector) {
+            sumX += sign * entry.x;
+            sumY += sign * entry.y;
+            sumZ += sign * entry.z;
+        }
+    }
+
+    void rebuild()
+    {
+        sum = sumSq = sumX = sumY = sumZ = 0.0;
+        for (std::size_t i = 0; i < entries.size(); ++i)
+            accumulate(entries[i], 1.0);
+        evicted = 0;
+    }
+
+    double value(Aggregate aggregate)
+    {
+        const double n = static_cast<double>(entries.size());
+        switch (aggregate) {
+        case Aggregate::Mean:
+            return sum / n;
+        case Aggregate::Rms: {
+            // E[v²] - E[v]²; dla modułu E[|a|²] - |E[a]|², czyli drgania wszystkich osi wokół średniej
+            const double squares = vector ? sumX * sumX + sumY * sumY + sumZ * sumZ : sum * sum;
+            return std::sqrt(std::max(n * sumSq - squares, 0.0)) / n;
+        }
+        case Aggregate::Peak:
+            return maxima.front().value;
+        case Aggregate::Min:
+            return minima.front().value;
+        default:
+            return entries.back().value;
+        }
+    }
+};
+
+EventDetector::RuleSet EventDetector::defaultRules()
+{
+    RuleSet rules;
+
+    // Swobodny spadek: średni moduł bliski zeru przez kilka próbek
+    Rule freeFall;
+    freeFall.name = "free-fall";
+    freeFall.quantity = Quantity::Magnitude;
+    freeFall.aggregate = Aggregate::Mean;
+    freeFall.windowNs = 100'000'000;
+    freeFall.compare = Compare::Below;
+    freeFall.threshold = 0.35;
+    freeFall.release = 0.6;
+    freeFall.holdNs = 60'000'000;
+    rules.push_back(freeFall);
+
+    // Uderzenie: pojedyncza próbka powyżej progu – bez okna i bez zwłoki
+    Rule impact;
+    impact.name = "impact";
+    impact.quantity = Quantity::Magnitude;
+    impact.aggregate = Aggregate::Instant;
+    impact.compare = Compare::Above;
+    impact.threshold = 3.0;
+    impact.release = 1.8;
+    rules.push_back(impact);
+
+    // Nadmierne drgania: RMS wektora przyspieszenia w oknie 0,5 s utrzymujący się przez sekundę
+    Rule vibration;
+    vibration.name = "vibration";
+    vibration.quantity = Quantity::Magnitude;
+    vibration.aggregate = Aggregate::Rms;
+    vibration.windowNs = 500'000'000;
+    vibration.compare = Compare::Above;
+    vibration.threshold = 0.5;
+    vibration.release = 0.35;
+    vibration.holdNs = 1'000'000'000;
+    rules.push_back(vibration);
+
+    return rules;
+}
+
+EventDetector::EventDetector() = default;
+
+EventDetector::~EventDetector() = default;
+
+void EventDetector::setRules(std::shared_ptr<const RuleSet> rules)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pending = std::move(rules);
+    m_hasPending = true;
+}
+
+// Okna są współdzielone przez reguły o tej samej wielkości i długości okna
+void EventDetector::configure()
+{
+    m_windows.clear();
+    m_ruleStates.clear();
+    m_hasPrevious = false;
+    m_needsJerk = false;
+    if (!m_rules)
+        return;
+
+    m_ruleStates.resize(m_rules->size());
+    for (std::size_t r = 0; r < m_rules->size(); ++r) {
+        const Rule& rule = (*m_rules)[r];
+        if (rule.quantity == Quantity::Jerk)
+            m_needsJerk = true;
+        if (rule.aggregate == Aggregate::Instant)
+            continue;
+
+        const std::int64_t length = std::max<std::int64_t>(rule.windowNs, 1);
+        auto it = std::find_if(m_windows.begin(), m_windows.end(), [&](const Window& window) {
+            return window.quantity == rule.quantity && window.length == length;
+        });
+        if (it == m_windows.end()) {
+            m_windows.emplace_back();
+            it = m_windows.end() - 1;
+            it->quantity = rule.quantity;
+            it->length = length;
+        }
+        it->sums |= rule.aggregate == Aggregate::Mean || rule.aggregate == Aggregate::Rms;
+        it->vector |= rule.aggregate == Aggregate::Rms && rule.quantity == Quantity::Magnitude;
+        it->peak |= rule.aggregate == Aggregate::Peak;
+        it->min |= rule.aggregate == Aggregate::Min;
+        m_ruleStates[r].window = static_cast<int>(it - m_windows.begin());
+    }
+}
+
+void EventDetector::process(const AccSample* samples, std::size_t count, std::vector<Event>& events)
+{
+    // Reguły są podmieniane między blokami, więc okna nigdy nie widzą ich w połowie zmiany
+    if (m_hasPending.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_rules = std::move(m_pending);
+        m_hasPending = false;
+        configure();
+    }
+    if (m_ruleStates.empty())
+        return;
+
+    const RuleSet& rules = *m_rules;
+    for (std::size_t i = 0; i < count; ++i) {
+        const AccSample& sample = samples[i];
+        const double magnitude = std::sqrt(sample.x * sample.x + sample.y * sample.y + sample.z * sample.z);
+        double jerk = 0.0;
+        if (m_needsJerk && m_hasPrevious && sample.timestamp > m_previous.timestamp) {
+            const double dx = sample.x - m_previous.x;
+            const double dy = sample.y - m_previous.y;
+            const double dz = sample.z - m_previous.z;
+            jerk = std::sqrt(dx * dx + dy * dy + dz * dz) * 1e9 / static_cast<double>(sample.timestamp - m_previous.timestamp);
+        }
+        m_previous = sample;
+        m_hasPrevious = true;
+
+        for (Window& window : m_windows)
+            window.push(sample, window.quantity == Quantity::Magnitude ? magnitude : jerk);
+
+        for (std::size_t r = 0; r < m_ruleStates.size(); ++r) {
+            const Rule& rule = rules[r];
+            RuleState& state = m_ruleStates[r];
+            const double value = state.window >= 0
+                ? m_windows[static_cast<std::size_t>(state.window)].value(rule.aggregate)
+                : (rule.quantity == Quantity::Magnitude ? magnitude : jerk);
+            const bool above = rule.compare == Compare::Above;
+
+            if (!state.active) {
+                if (above ? value <= rule.threshold : value >= rule.threshold) {
+                    state.pending = false;
+                    continue;
+                }
+                if (!state.pending) {
+                    state.pending = true;
+                    state.onset = sample.timestamp;
+                }
+                if (sample.timestamp - state.onset < rule.holdNs)
+                    continue;
+                state.pending = false;
+                state.active = true;
+                state.peak = value;
+                events.push_back({Event::Kind::Raised, static_cast<int>(r), rule.name, value, value,
+                                  state.onset, sample.timestamp});
+                continue;
+            }
+
+            if (above ? value > state.peak : value < state.peak)
+                state.peak = value;
+            // Histereza: próg odwołania nie może leżeć po stronie zgłoszenia
+            const double release = above ? std::min(rule.release, rule.threshold)
+                                         : std::max(rule.release, rule.threshold);
+            if (above ? value < release : value > release) {
+                state.active = false;
+                events.push_back({Event::Kind::Cleared, static_cast<int>(r), rule.name, value, state.peak,
+                                  sample.timestamp, sample.timestamp});
+            }
+        }
+    }
+}
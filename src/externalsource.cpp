@@ -0,0 +1,49 @@
+#include "externalsource.hpp"
+
+ExternalSource::ExternalSource(QObject *parent)
+    : SampleSource(parent)
+{
+}
+
+void ExternalSource::start()
+{
+    running = true;
+}
+
+void ExternalSource::stop()
+{
+    running = false;
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.clear();
+}
+
+bool ExternalSource::isRunning() const
+{
+    return running.load();
+}
+
+AccSampleBlock ExternalSource::poll(std::int64_t now)
+{
+    (void)now;  // Znaczniki czasu nadaje dostawca danych
+    AccSampleBlock block;
+    std::lock_guard<std::mutex> lock(mutex);
+    block.swap(pending);
+    return block;
+}
+
+void ExternalSource::push(const AccSampleBlock& block)
+{
+    if (!running.load() || block.isEmpty())
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pending.size() + block.size() > MaxPendingSamples) {
+        dropped.fetch_add(static_cast<quint64>(block.size()), std::memory_order_relaxed);
+        return;
+    }
+    pending += block;
+}
+
+quint64 ExternalSource::droppedSamples() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,40 @@
+#include "filterstage.hpp"
+#include "pipelinestats.hpp"
+
+void FilterStage::setChain(std::shared_ptr<dsp::FilterChain> chain)
+{
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    m_pending = std::move(chain);
+    m_hasPending = true;
+}
+
+AccSampleBlock FilterStage::process(const AccSampleBlock& block)
+{
+    // Łańcuch jest podmieniany między blokami, więc filtr nigdy nie widzi go w połowie zmiany
+    if (m_hasPending.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_chain = std::move(m_pending);
+        m_hasPending = false;
+    }
+
+    if (!m_chain || m_chain->empty() || block.isEmpty())
+        return block;
+
+    PipelineStats::ScopedTimer stats(PipelineStats::Stage::Filter, block.size());
+
+    // AoS -> SoA: każda oś w osobnej ciągłej tablicy dla jąder wektorowych
+    const qsizetype count = block.size();
+    m_soa.resize(static_cast<std::size_t>(count));
+    for (qsizetype i = 0; i < count; ++i) {
+        m_soa.x[i] = block[i].x;
+        m_soa.y[i] = block[i].y;
+        m_soa.z[i] = block[i].z;
+    }
+
+    m_chain->process(m_soa);
+
+    AccSampleBlock filtered(count);
+    for (qsizetype i = 0; i < count; ++i)
+        filtered[i] = {block[i].timestamp, m_soa.x[i], m_soa.y[i], m_soa.z[i]};
+    return filtered;
+}
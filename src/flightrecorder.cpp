@@ -0,0 +1,204 @@
+#include "flightrecorder.hpp"
+#include <QMutexLocker>
+#include <QThread>
+#include <cstring>
+
+FlightRecorder::FlightRecorder(QObject *parent)
+    : QObject(parent)
+{
+    chunk.reserve(ChunkSamples);
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    stop();
+}
+
+bool FlightRecorder::start(const QString& path)
+{
+    if (isRecording())
+        return false;
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = file.errorString();
+        return false;
+    }
+
+    FlightRecordFormat::FileHeader header;
+    std::memcpy(header.magic, FlightRecordFormat::FileMagic, sizeof(header.magic));
+    header.version = FlightRecordFormat::Version;
+    header.sampleSize = sizeof(AccSample);
+    if (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+        error = file.errorString();
+        file.close();
+        return false;
+    }
+
+    chunk.clear();
+    index.clear();
+    stopRequested = false;
+    pendingSamples = 0;
+    failed = false;
+    written = 0;
+    dropped = 0;
+
+    writerThread = QThread::create([this]() { writerLoop(); });
+    writerThread->setObjectName("FlightRecorder");
+    writerThread->start(QThread::LowPriority);
+    return true;
+}
+
+void FlightRecorder::stop()
+{
+    if (!writerThread)
+        return;
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+    }
+    wake.wakeOne();
+    writerThread->wait();
+    delete writerThread;
+    writerThread = nullptr;
+}
+
+bool FlightRecorder::isRecording() const
+{
+    return writerThread != nullptr;
+}
+
+QString FlightRecorder::errorString() const
+{
+    QMutexLocker locker(&mutex);
+    return error;
+}
+
+quint64 FlightRecorder::recordedSamples() const
+{
+    return written.load(std::memory_order_relaxed);
+}
+
+quint64 FlightRecorder::droppedSamples() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+// Wywoływane w wątku GUI – tylko odłożenie uchwytu bloku do kolejki
+void FlightRecorder::record(const AccSampleBlock& block)
+{
+    if (!writerThread || block.isEmpty())
+        return;
+    {
+        QMutexLocker locker(&mutex);
+        if (failed.load(std::memory_order_relaxed) || pendingSamples + block.size() > MaxPendingSamples) {
+            dropped.fetch_add(static_cast<quint64>(block.size()), std::memory_order_relaxed);
+            return;
+        }
+        pending.append(block);
+        pendingSamples += block.size();
+    }
+    wake.wakeOne();
+}
+
+void FlightRecorder::writerLoop()
+{
+    QVector<AccSampleBlock> batch;
+    bool finishing = false;
+    while (!finishing && !failed.load()) {
+        {
+            QMutexLocker locker(&mutex);
+            if (pending.isEmpty() && !stopRequested) {
+                // Brak nowych danych przez FlushIntervalMs – niepełna porcja idzie na dysk
+                if (!wake.wait(&mutex, FlushIntervalMs) && pending.isEmpty()) {
+                    locker.unlock();
+                    writeChunk();
+                    file.flush();
+                    continue;
+                }
+            }
+            batch.swap(pending);
+            pendingSamples = 0;
+            finishing = stopRequested;
+        }
+
+        for (const AccSampleBlock& block : batch)
+            append(block);
+        batch.clear();
+    }
+
+    // Po błędzie plik zostaje bez indeksu – odtwarzacz odbuduje go, przeglądając porcje
+    if (!failed.load()) {
+        writeChunk();
+        writeIndex();
+    } else {
+        dropped.fetch_add(chunk.size(), std::memory_order_relaxed);
+        chunk.clear();
+    }
+    file.close();
+}
+
+// Zapis w całości albo przerwanie nagrywania: błąd jest zapamiętywany, a wątek zapisu kończy pracę;
+// zaległe bloki są liczone jako odrzucone
+bool FlightRecorder::writeAll(const void* data, qint64 size)
+{
+    if (failed.load())
+        return false;
+    if (file.write(static_cast<const char*>(data), size) == size)
+        return true;
+    const QString message = file.errorString();
+    {
+        QMutexLocker locker(&mutex);
+        error = message;
+        failed = true;
+        dropped.fetch_add(static_cast<quint64>(pendingSamples), std::memory_order_relaxed);
+        pending.clear();
+        pendingSamples = 0;
+    }
+    emit writeFailed(message);
+    return false;
+}
+
+void FlightRecorder::append(const AccSampleBlock& block)
+{
+    for (const AccSample& sample : block) {
+        chunk.push_back(sample);
+        if (chunk.size() == ChunkSamples)
+            writeChunk();
+    }
+}
+
+void FlightRecorder::writeChunk()
+{
+    if (chunk.empty())
+        return;
+
+    FlightRecordFormat::ChunkHeader header;
+    header.magic = FlightRecordFormat::ChunkMagic;
+    header.count = static_cast<std::uint32_t>(chunk.size());
+    header.firstTimestamp = chunk.front().timestamp;
+    header.lastTimestamp = chunk.back().timestamp;
+
+    const std::uint64_t offset = static_cast<std::uint64_t>(file.pos());
+    const bool ok = writeAll(&header, sizeof(header))
+                    && writeAll(chunk.data(), static_cast<qint64>(chunk.size() * sizeof(AccSample)));
+    if (ok) {
+        index.append({header.firstTimestamp, offset});
+        written.fetch_add(chunk.size(), std::memory_order_relaxed);
+    } else {
+        dropped.fetch_add(chunk.size(), std::memory_order_relaxed);
+    }
+    chunk.clear();
+}
+
+// Stopka z indeksem czasu – pozwala odtwarzaczowi od razu wyszukiwać binarnie
+void FlightRecorder::writeIndex()
+{
+    FlightRecordFormat::IndexTrailer trailer;
+    trailer.indexOffset = static_cast<std::uint64_t>(file.pos());
+    trailer.entryCount = static_cast<std::uint32_t>(index.size());
+    trailer.magic = FlightRecordFormat::IndexMagic;
+
+    if (writeAll(index.constData(), static_cast<qint64>(index.size() * sizeof(FlightRecordFormat::IndexEntry))))
+        writeAll(&trailer, sizeof(trailer));
+}
@@ -1,31 +1,37 @@
 #include "mainwindow.hpp"
+#include "startupprofile.hpp"
 #include <QApplication>
+#include <QDebug>
 #include <QLocale>
 #include <QTranslator>
 
 int main(int argc, char *argv[])
 {
+    StartupProfile::mark("main");
+
     // Tworzenie aplikacji Qt
     QApplication a(argc, argv);
+    StartupProfile::mark("application");
 
-    // Tworzenie obiektu tłumacza
+    // Tłumaczenie dla języków systemu w jednym wywołaniu – QTranslator sam sprawdza kolejne
+    // warianty z QLocale::uiLanguages() w skompilowanych plikach wbudowanych w zasoby (:/i18n)
     QTranslator translator;
+    if (translator.load(QLocale(), "moj_projekt", "_", ":/i18n"))
+        a.installTranslator(&translator);
+    StartupProfile::mark("translations");
 
-    // Pobranie listy dostępnych języków interfejsu użytkownika z systemu
-    const QStringList uiLanguages = QLocale::system().uiLanguages();
-
-    // Iteracja po dostępnych językach
-    for (const QString &locale : uiLanguages) {
-        // Tworzenie nazwy pliku z tłumaczeniem na podstawie lokalizacji
-        const QString baseName = "moj_projekt_" + QLocale(locale).name();
-        if (translator.load(":/i18n/" + baseName)) {
-            a.installTranslator(&translator);
-            break;
-        }
-    }
     // Tworzenie i wyświetlanie głównego okna aplikacji
     MainWindow w;
+    StartupProfile::mark("mainwindow");
     w.show();
+    StartupProfile::mark("show");
+
+    // Czas do pierwszej klatki liczony od startu procesu (łącznie z ładowaniem bibliotek)
+    StartupProfile::onFirstPaint(&w, [](std::int64_t) {
+        StartupProfile::mark("first paint");
+        qInfo().noquote() << "Startup:" << StartupProfile::summary();
+    });
+
     // Uruchomienie głównej pętli aplikacji
     return a.exec();
 }
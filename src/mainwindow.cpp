@@ -1,10 +1,21 @@
 #include "mainwindow.hpp"
 #include "ui/ui_mainwindow.h"
+#include "chartwindow.hpp"
+#include "externalsource.hpp"
+#include "replaysource.hpp"
+#include "startupprofile.hpp"
+#include "telemetrystore.hpp"
 #include <QDebug>
 #include <QSerialPortInfo>
 #include <QList>
 #include <QComboBox>
 #include <QDateTime>
+#include <QFileDialog>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QStatusBar>
+#include <QTimer>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -18,39 +29,248 @@ MainWindow::MainWindow(QWidget *parent)
                                            0.01, -1.23, 3.14);
 
     simulationController = new SimulationController(this);
-    connect(simulationController, &SimulationController::newData,
-            spinController,      &SpinBoxController::updateAll);
+    connect(simulationController, &SimulationController::newBlock,
+            spinController,      &SpinBoxController::updateBlock);
 
-    //this->device = new QSerialPort(this);  // (Opcjonalnie) Inicjalizacja portu szeregowego (komentarz, bo nieaktywne)
+    // Historia wszystkich strumieni trafia do wspólnego magazynu, niezależnego od okien wykresów.
+    // Dopisywanie odbywa się w wątkach puli – wątek GUI dostaje tylko zbiorcze powiadomienie magazynu
+    TelemetryStore* store = TelemetryStore::instance();
+    const QList<int> ids = simulationController->streamIds();
+    for (int id : ids)
+        store->addSeries(id, simulationController->streamName(id));
+    connect(simulationController, &SimulationController::streamAdded, store, &TelemetryStore::addSeries);
+    connect(simulationController, &SimulationController::streamRemoved, store, &TelemetryStore::removeSeries);
+    connect(simulationController, &SimulationController::streamBlock, store, &TelemetryStore::append,
+            Qt::DirectConnection);
+    connect(simulationController, &SimulationController::intervalReset, store, &TelemetryStore::resetInterval,
+            Qt::DirectConnection);
+
+    // Odczyty: najnowsza wartość albo min/średnia/max z taktu wyświetlania, opcjonalnie z podtrzymaniem szczytu
+    connect(ui->comboBoxReadout, &QComboBox::currentIndexChanged, this, [this](int index) {
+        static const SpinBoxController::Mode modes[] = {
+            SpinBoxController::Mode::Latest, SpinBoxController::Mode::Minimum,
+            SpinBoxController::Mode::Average, SpinBoxController::Mode::Maximum,
+            SpinBoxController::Mode::Latest
+        };
+        spinController->setMode(modes[std::clamp(index, 0, 4)]);
+        spinController->setPeakHold(index == 4 ? 2000 : 0);
+    });
+
+    // Częstotliwość symulacji ustawiana z GUI (do 10 kHz)
+    simulationController->setSampleRate(ui->spinBoxRate->value());
+    connect(ui->spinBoxRate, &QSpinBox::valueChanged, this, [this](int hz) {
+        simulationController->setSampleRate(hz);
+    });
+
+    // Filtracja wybierana z listy; łańcuch jest budowany dla bieżącej częstotliwości próbkowania
+    connect(ui->comboBoxFilter, &QComboBox::currentIndexChanged, this, &MainWindow::applyFilterPreset);
+    connect(ui->spinBoxRate, &QSpinBox::valueChanged, this, [this]() {
+        applyFilterPreset(ui->comboBoxFilter->currentIndex());
+    });
+
+    // Liczba symulowanych czujników; nowe strumienie dostają własny łańcuch filtrów
+    connect(ui->spinBoxStreams, &QSpinBox::valueChanged, this, [this](int count) {
+        simulationController->setSimulatedStreams(count);
+        applyFilterPreset(ui->comboBoxFilter->currentIndex());
+    });
+
+    // Udostępnienie danych lokalnym procesom analizy (pierścień w pamięci współdzielonej),
+    // włączane zmienną środowiskową MOJ_TELEMETRY_SHM z nazwą segmentu, np. /qtdrone-telemetry
+    const QString shmName = qEnvironmentVariable("MOJ_TELEMETRY_SHM");
+    if (!shmName.isEmpty()) {
+        QString error;
+        if (!simulationController->startSharedMemory(shmName, &error))
+            qWarning() << "Shared memory" << shmName << ":" << error;
+    }
+
+    // Alarmy detektora zdarzeń (swobodny spadek, uderzenie, drgania) – reguły ocenia pula wątków
+    connect(simulationController, &SimulationController::detectorEvent, this, &MainWindow::showDetectorEvent);
+
+    // Rejestrator dostaje te same bloki co wyświetlacze; zapis na dysk odbywa się w tle
+    recorder = new FlightRecorder(this);
+    connect(simulationController, &SimulationController::rawBlock,
+            recorder,             &FlightRecorder::record);
+    // Błąd zapisu (np. pełny dysk) kończy nagrywanie – użytkownik musi o tym wiedzieć
+    connect(recorder, &FlightRecorder::writeFailed, this, [this](const QString &message) {
+        recorder->stop();
+        ui->pushButtonRecord->setText("Record");
+        QMessageBox::warning(this, "Record", "Recording stopped: " + message);
+    });
+
+    // Eksport obejmuje wszystkie strumienie po filtracji; bloki odkładane w wątkach puli, kodowanie i zapis w tle
+    exporter = new SessionExporter(this);
+    connect(simulationController, &SimulationController::streamBlock,
+            exporter,             &SessionExporter::record, Qt::DirectConnection);
+    connect(exporter, &SessionExporter::writeFailed, this, [this](const QString &message) {
+        exporter->stop();
+        ui->pushButtonExport->setText("Export");
+        QMessageBox::warning(this, "Export", "Export stopped: " + message);
+    });
+
+    // Koniec odtwarzanego nagrania – przycisk Start wraca do stanu początkowego
+    connect(simulationController, &SimulationController::sourceFinished, this, [this]() {
+        ui->pushButtonStart->setText("Start");
+        ui->pushButtonStart->setStyleSheet("");
+    });
+
+    // Odczyt z portu szeregowego działa we własnym wątku, GUI tylko opróżnia bufor pierścieniowy
+    serialReader = new SerialReader(this);
+    serialBuffer.resize(4096);
+    connect(serialReader, &SerialReader::samplesAvailable, this, &MainWindow::drainSerial);
+    // Port zastępuje źródło strumienia 0 (jak odtwarzanie), więc jego próbki nie mieszają się z symulatorem
+    connect(serialReader, &SerialReader::started, this, [this]() {
+        ExternalSource* serial = new ExternalSource();
+        serial->start();
+        simulationController->setSource(serial);
+        replaying = false;
+        ui->pushButtonReplay->setText("Replay");
+        ui->pushButtonStart->setText("Start");
+        ui->pushButtonStart->setStyleSheet("");
+        ui->pushButtonConnect->setText("Disconnect");
+    });
+    connect(serialReader, &SerialReader::stopped, this, [this]() {
+        if (!replaying)
+            simulationController->setSource(nullptr);  // Powrót do symulatora (odtwarzanie zostaje)
+        ui->pushButtonConnect->setText("Connect");
+    });
+    connect(serialReader, &SerialReader::errorOccurred, this, [this](const QString &message) {
+        qWarning() << "Serial port:" << message;
+    });
+
+    // Okno wykresów jest budowane w tle dopiero po pierwszej klatce okna głównego, po jednym
+    // wykresie na obrót pętli zdarzeń – ani start, ani pierwsze kliknięcie nie czekają
+    StartupProfile::onFirstPaint(this, [this](std::int64_t) {
+        QTimer::singleShot(0, this, &MainWindow::prewarmCharts);
+    });
 }
 
 MainWindow::~MainWindow()
 {
-    // Usuwanie obiektów, aby zwolnić pamięć
+    // Usuwanie obiektów, aby zwolnić pamięć; okno wykresów nie ma rodzica (może być też ukryte)
+    if (chartWindow) {
+        disconnect(chartWindow, nullptr, this, nullptr);
+        delete chartWindow;
+    }
     delete translator;
+    delete recorder;
+    delete exporter;
+    delete serialReader;
     delete simulationController;
     delete ui;
 }
 
-// Funkcja obsługująca kliknięcie przycisku "Charts" - otwiera nowe okno z wykresami
+// Funkcja obsługująca kliknięcie przycisku "Charts" - pokazuje okno z wykresami
 void MainWindow::on_pushButtonCharts_clicked()
 {
-    // Jeśli okno wykresów nie zostało jeszcze utworzone lub zostało zamknięte
-    if (!chartWindow || !chartWindow->isVisible()) {
-        chartWindow = new ChartWindow();  // Tworzenie nowego okna z wykresami
-        chartWindow->setAttribute(Qt::WA_DeleteOnClose);  // Ustawienie, aby okno było usuwane po zamknięciu
+    const std::int64_t clicked = accTimestampNow();
+    const bool prewarmed = chartWindow != nullptr;
+    if (!chartWindow)
+        createChartWindow(false);  // Okno nie zostało jeszcze przygotowane w tle – budowa teraz
 
-        // Po zamknięciu okna wykresów ustaw wskaźnik na nullptr
-        connect(chartWindow, &QObject::destroyed, this, [this]() {
-            chartWindow = nullptr;
+    // Dane i lista strumieni pochodzą z magazynu telemetrii – okno od razu pokazuje całą historię
+    if (!chartWindow->isVisible()) {
+        StartupProfile::onFirstPaint(chartWindow, [clicked, prewarmed](std::int64_t painted) {
+            qInfo().noquote() << QString("Charts: first paint %1 ms after click%2")
+                                     .arg((painted - clicked) / 1e6, 0, 'f', 1)
+                                     .arg(prewarmed ? " (prewarmed)" : "");
         });
+    }
+    chartWindow->show();  // Wyświetlanie okna z wykresami
+    chartWindow->raise();
+}
 
-        // Podłączenie sygnału z symulacji do metody aktualizującej dane w wykresach
-        connect(simulationController, &SimulationController::newData,
-                chartWindow, &ChartWindow::updateData);
+void MainWindow::createChartWindow(bool deferred)
+{
+    // Zamknięcie tylko ukrywa okno (bez WA_DeleteOnClose): dane są w magazynie telemetrii, więc
+    // ponowne otwarcie jest natychmiastowe, a ukryte okno nie odświeża wykresów. Usuwa je ~MainWindow
+    chartWindow = new ChartWindow(nullptr, nullptr, deferred);  // Tworzenie nowego okna z wykresami
+}
 
-        chartWindow->show();  // Wyświetlanie okna z wykresami
+// Budowa okna wykresów bez pokazywania: sceny QtCharts, osie i pierwsze renderowanie (czcionki,
+// układ) poza ścieżką krytyczną. Każdy krok to jeden wykres siatki, a między krokami pętla
+// zdarzeń obsługuje okno główne – najdłuższy krok to najdłuższa możliwa blokada GUI.
+void MainWindow::prewarmCharts()
+{
+    if (chartWindow)
+        return;
+    createChartWindow(true);
+    prewarmStarted = accTimestampNow();
+    prewarmLongestStep = 0;
+    prewarmSteps = 0;
+    QTimer::singleShot(0, this, &MainWindow::prewarmStep);
+}
+
+void MainWindow::prewarmStep()
+{
+    // Okno pokazane w międzyczasie (resztę buduje jego showEvent) albo zamknięte
+    if (!chartWindow || chartWindow->isVisible())
+        return;
+    const std::int64_t start = accTimestampNow();
+    const bool more = chartWindow->buildStep();
+    prewarmLongestStep = std::max(prewarmLongestStep, accTimestampNow() - start);
+    ++prewarmSteps;
+    if (more) {
+        QTimer::singleShot(0, this, &MainWindow::prewarmStep);
+        return;
+    }
+    StartupProfile::mark("charts prewarmed");
+    qInfo().noquote() << QString("Charts: prewarmed in %1 steps over %2 ms, longest step %3 ms")
+                             .arg(prewarmSteps)
+                             .arg((accTimestampNow() - prewarmStarted) / 1e6, 0, 'f', 1)
+                             .arg(prewarmLongestStep / 1e6, 0, 'f', 1);
+    qInfo().noquote() << "Startup:" << StartupProfile::summary();
+}
+
+// Funkcja obsługująca kliknięcie przycisku "Spectrum" - otwiera okno widma drgań
+void MainWindow::on_pushButtonSpectrum_clicked()
+{
+    if (!spectrumWindow) {
+        spectrumWindow = new SpectrumWindow();
+        spectrumWindow->setAttribute(Qt::WA_DeleteOnClose);
+        connect(spectrumWindow, &QObject::destroyed, this, [this]() {
+            spectrumWindow = nullptr;
+        });
+
+        // Bloki trafiają prosto do wątku analizatora (połączenie kolejkowane, bez kopiowania danych)
+        connect(simulationController, &SimulationController::newBlock,
+                spectrumWindow->analyzer(), &SpectrumAnalyzer::process);
+    }
+    spectrumWindow->show();
+    spectrumWindow->raise();
+}
+
+// Funkcja obsługująca kliknięcie przycisku "Stats" - panel statystyk toru danych
+void MainWindow::on_pushButtonStats_clicked()
+{
+    if (!statsPanel) {
+        statsPanel = new StatsPanel();
+        statsPanel->setAttribute(Qt::WA_DeleteOnClose);
+        connect(statsPanel, &QObject::destroyed, this, [this]() {
+            statsPanel = nullptr;
+        });
     }
+    statsPanel->show();
+    statsPanel->raise();
+}
+
+// Zgłoszenie lub odwołanie zdarzenia: komunikat na pasku stanu i w logu wraz z opóźnieniem wykrycia
+// (od pierwszej próbki spełniającej warunek i od próbki, na której zdarzenie rozpoznano)
+void MainWindow::showDetectorEvent(int streamId, const EventDetector::Event& event)
+{
+    const QString name = QString::fromStdString(event.name);
+    const QString stream = simulationController->streamName(streamId);
+    if (event.kind == EventDetector::Event::Kind::Cleared) {
+        statusBar()->showMessage(QString("%1 cleared on %2 (peak %3)").arg(name, stream).arg(event.peak, 0, 'f', 2), 5000);
+        qInfo().noquote() << "Event cleared:" << name << stream << "peak" << event.peak;
+        return;
+    }
+    const std::int64_t now = accTimestampNow();
+    const double onsetMs = (now - event.onset) / 1e6;
+    const double pipelineMs = (now - event.timestamp) / 1e6;
+    statusBar()->showMessage(QString("%1 on %2: %3 (latency %4 ms)")
+                                 .arg(name, stream).arg(event.value, 0, 'f', 2).arg(onsetMs, 0, 'f', 1));
+    qWarning().noquote() << "Event:" << name << stream << "value" << event.value
+                         << "latency" << onsetMs << "ms from onset," << pipelineMs << "ms in pipeline";
 }
 
 // Funkcja obsługująca kliknięcie przycisku zmiany języka
@@ -73,3 +293,145 @@ void MainWindow::on_pushButtonStart_clicked()
     }
 }
 
+// Funkcja obsługująca kliknięcie przycisku "Connect" - otwiera lub zamyka port szeregowy
+void MainWindow::on_pushButtonConnect_clicked()
+{
+    if (serialReader->isRunning()) {
+        serialReader->stop();
+        return;
+    }
+
+    // Lista wykrytych portów; pole jest edytowalne, więc można wpisać np. pseudo-terminal /dev/pts/N
+    QStringList ports;
+    const QList<QSerialPortInfo> available = QSerialPortInfo::availablePorts();
+    for (const QSerialPortInfo &info : available)
+        ports << info.systemLocation();
+
+    bool ok = false;
+    const QString portName = QInputDialog::getItem(this, "Connect", "Serial port:", ports, 0, true, &ok);
+    if (ok && !portName.isEmpty())
+        serialReader->start(portName);
+}
+
+// Opróżnienie pierścienia z próbkami z portu szeregowego (jedno wywołanie na porcję danych)
+void MainWindow::drainSerial()
+{
+    std::size_t count;
+    while ((count = serialReader->drain(serialBuffer.data(), serialBuffer.size())) > 0) {
+        // Porcja z pierścienia trafia do toru przetwarzania jako jeden blok, tak jak dane z symulatora
+        const AccSampleBlock block(serialBuffer.begin(), serialBuffer.begin() + static_cast<std::ptrdiff_t>(count));
+        simulationController->pushExternalBlock(block);
+    }
+}
+
+// Funkcja obsługująca kliknięcie przycisku "Record" - rozpoczyna lub kończy nagrywanie sesji
+void MainWindow::on_pushButtonRecord_clicked()
+{
+    if (recorder->isRecording()) {
+        recorder->stop();  // Dopisanie zaległych danych i indeksu
+        ui->pushButtonRecord->setText("Record");
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(this, "Record session", QString(), "Flight recordings (*.accrec)");
+    if (path.isEmpty())
+        return;
+    if (!recorder->start(path)) {
+        QMessageBox::warning(this, "Record", recorder->errorString());
+        return;
+    }
+    ui->pushButtonRecord->setText("Stop recording");
+}
+
+// Funkcja obsługująca kliknięcie przycisku "Export" - skompresowany eksport wszystkich strumieni
+void MainWindow::on_pushButtonExport_clicked()
+{
+    if (exporter->isExporting()) {
+        exporter->stop();  // Zakodowanie zaległych próbek
+        ui->pushButtonExport->setText("Export");
+        return;
+    }
+
+    const QString path = QFileDialog::getSaveFileName(this, "Export session", QString(), "Compressed sessions (*.accz)");
+    if (path.isEmpty())
+        return;
+    if (!exporter->start(path)) {
+        QMessageBox::warning(this, "Export", exporter->errorString());
+        return;
+    }
+    ui->pushButtonExport->setText("Stop export");
+}
+
+// Funkcja obsługująca kliknięcie przycisku "Replay" - podmienia symulator na odtwarzanie nagrania
+void MainWindow::on_pushButtonReplay_clicked()
+{
+    if (replaying) {
+        simulationController->setSource(nullptr);  // Powrót do symulatora
+        TelemetryStore::instance()->clearSeries(SimulationController::PrimaryStream);
+        replaying = false;
+        ui->pushButtonReplay->setText("Replay");
+        ui->pushButtonStart->setText("Start");
+        ui->pushButtonStart->setStyleSheet("");
+        return;
+    }
+
+    const QString path = QFileDialog::getOpenFileName(this, "Replay session", QString(), "Flight recordings (*.accrec)");
+    if (path.isEmpty())
+        return;
+
+    ReplaySource* replay = new ReplaySource();
+    if (!replay->open(path)) {
+        QMessageBox::warning(this, "Replay", replay->errorString());
+        delete replay;
+        return;
+    }
+
+    // 1 = czas rzeczywisty, N = N razy szybciej, 0 = najszybciej, jak się da
+    bool ok = false;
+    const double speed = QInputDialog::getDouble(this, "Replay", "Speed (0 = as fast as possible):", 1.0, 0.0, 1000.0, 1, &ok);
+    if (!ok) {
+        delete replay;
+        return;
+    }
+    replay->setSpeed(speed);
+
+    simulationController->setSource(replay);
+    // Odtwarzanie to nowa sesja (znaczniki przeliczone na bieżący zegar) – historia strumienia 0 od nowa
+    TelemetryStore::instance()->clearSeries(SimulationController::PrimaryStream);
+    replaying = true;
+    ui->pushButtonReplay->setText("Live");
+    ui->pushButtonStart->setText("Start");
+    ui->pushButtonStart->setStyleSheet("");
+}
+
+// Budowa łańcucha filtrów dla pozycji wybranej na liście – osobny egzemplarz dla każdego strumienia
+void MainWindow::applyFilterPreset(int index)
+{
+    const QList<int> ids = simulationController->streamIds();
+    for (int id : ids)
+        simulationController->setFilterChain(id, buildFilterChain(index));
+}
+
+std::shared_ptr<dsp::FilterChain> MainWindow::buildFilterChain(int index) const
+{
+    const double rate = simulationController->sampleRate();
+    auto chain = std::make_shared<dsp::FilterChain>();
+    switch (index) {
+    case 1:
+        chain->add(std::make_unique<dsp::Biquad>(dsp::Biquad::Type::LowPass, rate, 5.0));
+        break;
+    case 2:
+        chain->add(std::make_unique<dsp::Biquad>(dsp::Biquad::Type::HighPass, rate, 0.5));
+        break;
+    case 3:
+        chain->add(std::make_unique<dsp::MovingAverage>(16));
+        break;
+    case 4:
+        chain->add(std::make_unique<dsp::GravityRemoval>(rate));
+        break;
+    default:
+        chain.reset();  // Brak filtracji
+        break;
+    }
+    return chain;
+}
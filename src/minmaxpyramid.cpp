@@ -0,0 +1,130 @@
+#include "minmaxpyramid.hpp"
+#include <algorithm>
+
+MinMaxPyramid::MinMaxPyramid(std::size_t budgetBytes, std::size_t levels, std::size_t fanout)
+    : m_fanout(std::max<std::size_t>(fanout, 2))
+{
+    levels = std::max<std::size_t>(levels, 1);
+    // Budżet dzielony po równo między poziomy – każdy kolejny poziom sięga fanout razy dalej w przeszłość
+    const std::size_t perLevel = std::max<std::size_t>(budgetBytes / (levels * sizeof(Bucket)), 16);
+    m_levels.reserve(levels);
+    for (std::size_t i = 0; i < levels; ++i)
+        m_levels.emplace_back(perLevel);
+    m_pending.resize(levels);
+    m_pendingCount.assign(levels, 0);
+}
+
+void MinMaxPyramid::append(double time, double value)
+{
+    push(0, Bucket{time, time, value, value});
+}
+
+void MinMaxPyramid::push(std::size_t level, const Bucket& bucket)
+{
+    m_levels[level].push(bucket);
+    if (level + 1 == m_levels.size())
+        return;
+
+    // Doklejenie kubełka do agregatu poziomu wyżej; po zebraniu fanout sztuk – przeniesienie w górę
+    Bucket& pending = m_pending[level];
+    if (m_pendingCount[level] == 0) {
+        pending = bucket;
+    } else {
+        pending.t1 = bucket.t1;
+        pending.min = std::min(pending.min, bucket.min);
+        pending.max = std::max(pending.max, bucket.max);
+    }
+    if (++m_pendingCount[level] == m_fanout) {
+        m_pendingCount[level] = 0;
+        push(level + 1, pending);
+    }
+}
+
+void MinMaxPyramid::clear()
+{
+    for (CircularBuffer<Bucket>& level : m_levels)
+        level.clear();
+    std::fill(m_pendingCount.begin(), m_pendingCount.end(), 0);
+}
+
+std::size_t MinMaxPyramid::lowerBound(const CircularBuffer<Bucket>& level, double time) const
+{
+    std::size_t lo = 0;
+    std::size_t hi = level.size();
+    while (lo < hi) {
+        const std::size_t mid = lo + (hi - lo) / 2;
+        if (level[mid].t1 < time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+void MinMaxPyramid::query(double t0, double t1, std::size_t maxBuckets, std::vector<Bucket>& out) const
+{
+    out.clear();
+    if (empty() || t1 < t0)
+        return;
+    maxBuckets = std::max<std::size_t>(maxBuckets, 1);
+
+    // Najdrobniejszy poziom, który pokrywa początek przedziału i mieści się w limicie kubełków
+    std::size_t chosen = m_levels.size() - 1;
+    for (std::size_t i = 0; i < m_levels.size(); ++i) {
+        const CircularBuffer<Bucket>& level = m_levels[i];
+        if (level.empty())
+            break;
+        const std::size_t first = lowerBound(level, t0);
+        const std::size_t last = lowerBound(level, t1);
+        const bool coversStart = level.front().t0 <= t0 || i + 1 == m_levels.size()
+                                 || m_levels[i + 1].empty();
+        if (coversStart && last - first <= maxBuckets) {
+            chosen = i;
+            break;
+        }
+    }
+    while (chosen > 0 && m_levels[chosen].empty())
+        --chosen;
+
+    // Kubełki wybranego poziomu, a potem świeższe kubełki z poziomów niższych,
+    // które nie zostały jeszcze zagregowane (najwyżej fanout-1 na poziom)
+    double cursor = t0;
+    bool started = false;
+    for (std::size_t i = chosen + 1; i-- > 0;) {
+        const CircularBuffer<Bucket>& level = m_levels[i];
+        for (std::size_t n = lowerBound(level, cursor); n < level.size(); ++n) {
+            const Bucket& bucket = level[n];
+            if (bucket.t0 > t1)
+                break;
+            if (started && bucket.t0 <= cursor)
+                continue;
+            out.push_back(bucket);
+        }
+        if (!out.empty()) {
+            cursor = out.back().t1;
+            started = true;
+        }
+    }
+}
+
+double MinMaxPyramid::oldestTime() const
+{
+    for (std::size_t i = m_levels.size(); i-- > 0;) {
+        if (!m_levels[i].empty())
+            return m_levels[i].front().t0;
+    }
+    return 0.0;
+}
+
+double MinMaxPyramid::newestTime() const
+{
+    return m_levels[0].empty() ? 0.0 : m_levels[0].back().t1;
+}
+
+std::size_t MinMaxPyramid::memoryBytes() const
+{
+    std::size_t bytes = 0;
+    for (const CircularBuffer<Bucket>& level : m_levels)
+        bytes += level.capacity() * sizeof(Bucket);
+    return bytes;
+}
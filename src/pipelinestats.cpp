@@ -0,0 +1,221 @@
+#include "pipelinestats.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace PipelineStats {
+
+namespace {
+
+// Liczniki jednego wątku; pisze do nich wyłącznie ten wątek
+struct alignas(64) Shard
+{
+    struct Counters
+    {
+        std::atomic<std::uint64_t> events{0};
+        std::atomic<std::uint64_t> samples{0};
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<std::uint64_t> coalesced{0};
+        LatencyHistogram latency;
+    };
+    std::array<Counters, StageCount> stages;
+};
+
+inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// Rejestr wszystkich shardów; blokada tylko przy starcie/końcu wątku i przy migawce
+class Registry
+{
+public:
+    Shard* acquire()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Shard zakończonego wątku jest używany ponownie – sumy pozostają poprawne
+        if (!m_free.empty()) {
+            Shard* shard = m_free.back();
+            m_free.pop_back();
+            return shard;
+        }
+        m_shards.push_back(std::make_unique<Shard>());
+        return m_shards.back().get();
+    }
+
+    void release(Shard* shard)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_free.push_back(shard);
+    }
+
+    template <typename Function>
+    void forEach(Function&& function)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const std::unique_ptr<Shard>& shard : m_shards)
+            function(*shard);
+    }
+
+    struct Gauge
+    {
+        std::atomic<std::int64_t> depth{0};
+        std::atomic<std::int64_t> maxDepth{0};
+    };
+    std::array<Gauge, StageCount> gauges;
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::vector<Shard*> m_free;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+struct ShardHandle
+{
+    Shard* shard = registry().acquire();
+    ~ShardHandle() { registry().release(shard); }
+};
+
+inline Shard::Counters& local(Stage stage)
+{
+    thread_local ShardHandle handle;
+    return handle.shard->stages[static_cast<int>(stage)];
+}
+
+} // namespace
+
+const char* stageName(Stage stage)
+{
+    switch (stage) {
+    case Stage::Tick: return "tick";
+    case Stage::Source: return "source";
+    case Stage::Interval: return "interval";
+    case Stage::Filter: return "filter";
+    case Stage::Detect: return "detect";
+    case Stage::Dispatch: return "dispatch";
+    case Stage::SpinBox: return "spinbox";
+    case Stage::ChartAdd: return "chartAdd";
+    case Stage::ChartRefresh: return "chartRefresh";
+    case Stage::ChartPaint: return "chartPaint";
+    default: return "unknown";
+    }
+}
+
+void record(Stage stage, std::int64_t latencyNs, std::int64_t samples)
+{
+    Shard::Counters& counters = local(stage);
+    bump(counters.events, 1);
+    if (samples > 0)
+        bump(counters.samples, static_cast<std::uint64_t>(samples));
+    counters.latency.record(latencyNs > 0 ? static_cast<std::uint64_t>(latencyNs) : 0);
+}
+
+void addSamples(Stage stage, std::int64_t samples)
+{
+    if (samples > 0)
+        bump(local(stage).samples, static_cast<std::uint64_t>(samples));
+}
+
+void addDropped(Stage stage, std::int64_t samples)
+{
+    if (samples > 0)
+        bump(local(stage).dropped, static_cast<std::uint64_t>(samples));
+}
+
+void addCoalesced(Stage stage, std::int64_t count)
+{
+    if (count > 0)
+        bump(local(stage).coalesced, static_cast<std::uint64_t>(count));
+}
+
+// Kolejka ma dwóch pisarzy (nadawca i odbiorca), więc tu potrzebne są operacje atomowe
+void queueEnter(Stage stage)
+{
+    Registry::Gauge& gauge = registry().gauges[static_cast<int>(stage)];
+    const std::int64_t depth = gauge.depth.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::int64_t previous = gauge.maxDepth.load(std::memory_order_relaxed);
+    while (depth > previous && !gauge.maxDepth.compare_exchange_weak(previous, depth, std::memory_order_relaxed)) {
+    }
+}
+
+void queueLeave(Stage stage)
+{
+    registry().gauges[static_cast<int>(stage)].depth.fetch_sub(1, std::memory_order_relaxed);
+}
+
+Snapshot snapshot()
+{
+    Snapshot result;
+    result.timestamp = accTimestampNow();
+    registry().forEach([&result](const Shard& shard) {
+        for (int i = 0; i < StageCount; ++i) {
+            const Shard::Counters& counters = shard.stages[i];
+            StageSnapshot& stage = result.stages[i];
+            stage.events += counters.events.load(std::memory_order_relaxed);
+            stage.samples += counters.samples.load(std::memory_order_relaxed);
+            stage.dropped += counters.dropped.load(std::memory_order_relaxed);
+            stage.coalesced += counters.coalesced.load(std::memory_order_relaxed);
+            stage.latency.merge(counters.latency);
+        }
+    });
+    for (int i = 0; i < StageCount; ++i) {
+        result.stages[i].queueDepth = registry().gauges[i].depth.load(std::memory_order_relaxed);
+        result.stages[i].maxQueueDepth = registry().gauges[i].maxDepth.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+namespace {
+
+QJsonObject latencyJson(const HistogramSnapshot& histogram)
+{
+    QJsonObject latency;
+    latency["count"] = static_cast<qint64>(histogram.total);
+    latency["p50Us"] = histogram.percentile(0.50) / 1e3;
+    latency["p90Us"] = histogram.percentile(0.90) / 1e3;
+    latency["p99Us"] = histogram.percentile(0.99) / 1e3;
+    latency["maxUs"] = histogram.max / 1e3;
+    return latency;
+}
+
+} // namespace
+
+QJsonObject toJson(const Snapshot& current, const Snapshot* previous)
+{
+    const double seconds = previous ? (current.timestamp - previous->timestamp) / 1e9 : 0.0;
+
+    QJsonObject stages;
+    for (int i = 0; i < StageCount; ++i) {
+        const StageSnapshot& stage = current.stages[i];
+        QJsonObject entry;
+        entry["events"] = static_cast<qint64>(stage.events);
+        entry["samples"] = static_cast<qint64>(stage.samples);
+        entry["dropped"] = static_cast<qint64>(stage.dropped);
+        entry["coalesced"] = static_cast<qint64>(stage.coalesced);
+        entry["queueDepth"] = static_cast<qint64>(stage.queueDepth);
+        entry["maxQueueDepth"] = static_cast<qint64>(stage.maxQueueDepth);
+        entry["latencyTotal"] = latencyJson(stage.latency);
+        if (seconds > 0.0) {
+            const StageSnapshot& before = previous->stages[i];
+            entry["eventsPerSecond"] = (stage.events - before.events) / seconds;
+            entry["samplesPerSecond"] = (stage.samples - before.samples) / seconds;
+            entry["latencyInterval"] = latencyJson(stage.latency.since(before.latency));
+        }
+        stages[stageName(static_cast<Stage>(i))] = entry;
+    }
+
+    QJsonObject json;
+    json["timestampNs"] = static_cast<qint64>(current.timestamp);
+    if (seconds > 0.0)
+        json["intervalSeconds"] = seconds;
+    json["stages"] = stages;
+    return json;
+}
+
+} // namespace PipelineStats
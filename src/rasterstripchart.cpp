@@ -0,0 +1,251 @@
+#include "rasterstripchart.hpp"
+#include <QPainter>
+#include <QResizeEvent>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const QRgb RasterStripChart::background = qRgb(255, 255, 255);
+const QRgb RasterStripChart::gapBackground = qRgb(238, 238, 238);
+
+namespace {
+const QColor axisColors[3] = {QColor(31, 119, 180), QColor(44, 160, 44), QColor(214, 39, 40)};
+}
+
+RasterStripChart::RasterStripChart(QWidget *parent)
+    : QWidget(parent)
+{
+    // Cały obszar jest zamalowywany obrazem – bez czyszczenia tła przed rysowaniem
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(100, 60);
+}
+
+void RasterStripChart::setTitle(const QString &newTitle)
+{
+    title = newTitle;
+    update();
+}
+
+void RasterStripChart::setTimeWindow(double seconds)
+{
+    windowSeconds = seconds;
+    columnSeconds = seconds > 0.0 && image.width() > 0 ? seconds / image.width() : 0.0;
+    clearImage();
+}
+
+void RasterStripChart::setValueRange(double min, double max)
+{
+    valueMin = min;
+    valueMax = max;
+    clearImage();
+    emit rebuildRequested();
+}
+
+double RasterStripChart::toY(double value) const
+{
+    const double height = image.height() - 1;
+    return std::clamp((valueMax - value) / (valueMax - valueMin), 0.0, 1.0) * height;
+}
+
+void RasterStripChart::merge(Column &column, int axis, double min, double max) const
+{
+    const float lo = static_cast<float>(min);
+    const float hi = static_cast<float>(max);
+    if (!column.valid) {
+        for (int i = 0; i < 3; ++i) {
+            column.min[i] = std::numeric_limits<float>::max();
+            column.max[i] = std::numeric_limits<float>::lowest();
+        }
+        column.valid = true;
+    }
+    column.min[axis] = std::min(column.min[axis], lo);
+    column.max[axis] = std::max(column.max[axis], hi);
+}
+
+void RasterStripChart::append(double time, double x, double y, double z, bool afterGap)
+{
+    if (columnSeconds <= 0.0)
+        return;
+    const qint64 index = static_cast<qint64>(std::floor(time / columnSeconds));
+    if (hasCurrent && index < currentIndex)
+        return;
+    if (!hasCurrent || index > currentIndex) {
+        // Zakończenie bieżącej kolumny i puste kolumny do nowej próbki (najwyżej szerokość obrazu);
+        // przy rzadkich próbkach puste kolumny są zwykłe, tylko po przerwie – zaznaczone
+        if (hasCurrent) {
+            pending.push_back(current);
+            const qint64 empty = std::min<qint64>(index - currentIndex - 1, image.width());
+            Column filler;
+            filler.gap = afterGap;
+            for (qint64 i = 0; i < empty; ++i)
+                pending.push_back(filler);
+        }
+        current = Column();
+        currentIndex = index;
+        hasCurrent = true;
+    }
+    if (afterGap)
+        current.breakBefore = true;
+    merge(current, 0, x, x);
+    merge(current, 1, y, y);
+    merge(current, 2, z, z);
+}
+
+void RasterStripChart::flush()
+{
+    if (pending.empty())
+        return;
+    // Więcej kolumn niż szerokość obrazu – widać tylko najnowsze
+    const int width = image.width();
+    const int skip = std::max(0, static_cast<int>(pending.size()) - width);
+    rasterize(pending.data() + skip, static_cast<int>(pending.size()) - skip);
+    pending.clear();
+    update();
+}
+
+// Rysowanie kolejnych kolumn od writeX, z zawinięciem na początek obrazu.
+// Łamana każdej osi przechodzi przez (x, min) i (x, max) kolumn, jak seria w QtCharts.
+void RasterStripChart::rasterize(const Column *columns, int count)
+{
+    const int width = image.width();
+    if (width == 0 || count == 0)
+        return;
+
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing, false);
+    int done = 0;
+    while (done < count) {
+        // Odcinek do końca obrazu; po zawinięciu łamana startuje od punktu przesuniętego o szerokość
+        const int run = std::min(count - done, width - writeX);
+        painter.fillRect(writeX, 0, run, image.height(), QColor(background));
+        for (int i = 0; i < run;) {
+            if (!columns[done + i].gap) {
+                ++i;
+                continue;
+            }
+            int end = i;
+            while (end < run && columns[done + end].gap)
+                ++end;
+            painter.fillRect(writeX + i, 0, end - i, image.height(), QColor(gapBackground));
+            i = end;
+        }
+        const int zeroY = static_cast<int>(toY(0.0));
+        painter.setPen(QColor(220, 220, 220));
+        painter.drawLine(writeX, zeroY, writeX + run - 1, zeroY);
+
+        // Przerwa kończy łamaną; kolejna zaczyna się od pierwszej kolumny z danymi po niej
+        int n = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            painter.setPen(axisColors[axis]);
+            n = 0;
+            if (hasLastPoint)
+                polyline[n++] = lastPoint[axis];
+            for (int i = 0; i < run; ++i) {
+                const Column &column = columns[done + i];
+                if (column.gap || column.breakBefore) {
+                    if (n > 1)
+                        painter.drawPolyline(polyline.constData(), n);
+                    n = 0;
+                }
+                if (!column.valid)
+                    continue;
+                const double x = writeX + i;
+                polyline[n++] = QPointF(x, toY(column.min[axis]));
+                polyline[n++] = QPointF(x, toY(column.max[axis]));
+            }
+            if (n > 1)
+                painter.drawPolyline(polyline.constData(), n);
+            if (n > 0)
+                lastPoint[axis] = polyline[n - 1];
+        }
+        hasLastPoint = n > 0;
+        done += run;
+        writeX += run;
+        if (writeX >= width) {
+            writeX = 0;
+            for (QPointF &point : lastPoint)
+                point.rx() -= width;
+        }
+    }
+}
+
+void RasterStripChart::rebuild(double t0, double t1, const std::vector<MinMaxPyramid::Bucket> axes[3],
+                               const std::vector<std::pair<double, double>> &gaps)
+{
+    const int width = image.width();
+    if (width == 0 || t1 <= t0)
+        return;
+
+    // Siatka kolumn zakotwiczona w czasie bezwzględnym, żeby kolejne append() pasowały do niej
+    columnSeconds = (windowSeconds > 0.0 ? windowSeconds : t1 - t0) / width;
+    const qint64 newest = static_cast<qint64>(std::floor(t1 / columnSeconds));
+    const qint64 first = newest - width + 1;
+
+    std::vector<Column> columns(static_cast<std::size_t>(width));
+    for (int axis = 0; axis < 3; ++axis) {
+        for (const MinMaxPyramid::Bucket &bucket : axes[axis]) {
+            const qint64 c0 = std::max(first, static_cast<qint64>(std::floor(bucket.t0 / columnSeconds)));
+            const qint64 c1 = std::min(newest, static_cast<qint64>(std::floor(bucket.t1 / columnSeconds)));
+            for (qint64 c = c0; c <= c1; ++c)
+                merge(columns[static_cast<std::size_t>(c - first)], axis, bucket.min, bucket.max);
+        }
+    }
+    // Kolumny bez danych między końcami przerwy są jej częścią, kolumna z końcem przerwy zaczyna nową łamaną
+    for (const std::pair<double, double> &gap : gaps) {
+        const qint64 c0 = static_cast<qint64>(std::floor(gap.first / columnSeconds));
+        const qint64 c1 = static_cast<qint64>(std::floor(gap.second / columnSeconds));
+        for (qint64 c = std::max(first, c0 + 1); c < std::min(newest + 1, c1); ++c)
+            columns[static_cast<std::size_t>(c - first)].gap = !columns[static_cast<std::size_t>(c - first)].valid;
+        if (c1 >= first && c1 <= newest)
+            columns[static_cast<std::size_t>(c1 - first)].breakBefore = true;
+    }
+
+    clearImage();
+    rasterize(columns.data(), width);
+    pending.clear();
+    current = Column();
+    currentIndex = newest;
+    hasCurrent = true;
+    update();
+}
+
+void RasterStripChart::clearImage()
+{
+    image.fill(background);
+    writeX = 0;
+    hasLastPoint = false;
+    pending.clear();
+    current = Column();
+    hasCurrent = false;
+    update();
+}
+
+void RasterStripChart::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    image = QImage(event->size(), QImage::Format_RGB32);
+    polyline.resize(2 * event->size().width() + 2);
+    columnSeconds = windowSeconds > 0.0 && image.width() > 0 ? windowSeconds / image.width() : 0.0;
+    clearImage();
+    emit rebuildRequested();
+}
+
+void RasterStripChart::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    // Najstarsze kolumny [writeX, szerokość) z lewej, najnowsze [0, writeX) z prawej
+    const int width = image.width();
+    const int older = width - writeX;
+    painter.drawImage(QPoint(0, 0), image, QRect(writeX, 0, older, image.height()));
+    painter.drawImage(QPoint(older, 0), image, QRect(0, 0, writeX, image.height()));
+
+    painter.setPen(Qt::black);
+    painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignTop | Qt::AlignHCenter, title);
+    painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignTop | Qt::AlignLeft, QString::number(valueMax));
+    painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignBottom | Qt::AlignLeft, QString::number(valueMin));
+    for (int axis = 0; axis < 3; ++axis) {
+        painter.setPen(axisColors[axis]);
+        painter.drawText(rect().adjusted(4, 2, -4 - (2 - axis) * 14, -2), Qt::AlignTop | Qt::AlignRight,
+                         QString(QChar('X' + axis)));
+    }
+}
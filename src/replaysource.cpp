@@ -0,0 +1,242 @@
+#include "replaysource.hpp"
+#include "pipelinestats.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace FlightRecordFormat;
+
+ReplaySource::ReplaySource(QObject *parent)
+    : SampleSource(parent)
+{
+}
+
+ReplaySource::~ReplaySource()
+{
+    if (mapped)
+        file.unmap(mapped);
+}
+
+bool ReplaySource::open(const QString& path)
+{
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+    mappedSize = file.size();
+    if (mappedSize < static_cast<qint64>(sizeof(FileHeader))) {
+        error = "File too short";
+        return false;
+    }
+    mapped = file.map(0, mappedSize);
+    if (!mapped) {
+        error = file.errorString();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, FileMagic, sizeof(header.magic)) != 0
+        || header.sampleSize != sizeof(AccSample)) {
+        error = "Not a flight recording";
+        return false;
+    }
+
+    // Stopka z indeksem jest tylko w poprawnie zamkniętych plikach – w przeciwnym razie skan nagłówków
+    if (!loadIndex(mappedSize))
+        scanChunks(mappedSize);
+
+    totalSamples = 0;
+    for (const Chunk& chunk : chunks)
+        totalSamples += chunk.count;
+    return true;
+}
+
+QString ReplaySource::errorString() const
+{
+    return error;
+}
+
+bool ReplaySource::readChunk(quint64 offset, qint64 dataEnd, Chunk& out) const
+{
+    // Przesunięcia pochodzą z pliku – porównania przez odejmowanie, żeby suma nie mogła się przekręcić
+    const quint64 limit = static_cast<quint64>(dataEnd);
+    if (offset < sizeof(FileHeader) || limit < sizeof(ChunkHeader) || offset > limit - sizeof(ChunkHeader))
+        return false;
+    ChunkHeader header;
+    std::memcpy(&header, mapped + offset, sizeof(header));
+    const quint64 available = limit - offset - sizeof(ChunkHeader);
+    if (header.magic != ChunkMagic || header.count == 0 || header.count > available / sizeof(AccSample))
+        return false;
+
+    out.firstTimestamp = header.firstTimestamp;
+    out.lastTimestamp = header.lastTimestamp;
+    out.samples = reinterpret_cast<const AccSample*>(mapped + offset + sizeof(ChunkHeader));
+    out.count = header.count;
+    return true;
+}
+
+bool ReplaySource::loadIndex(qint64 dataEnd)
+{
+    if (dataEnd < static_cast<qint64>(sizeof(FileHeader) + sizeof(IndexTrailer)))
+        return false;
+    IndexTrailer trailer;
+    std::memcpy(&trailer, mapped + dataEnd - sizeof(IndexTrailer), sizeof(trailer));
+    const quint64 indexLimit = quint64(dataEnd) - sizeof(IndexTrailer);
+    if (trailer.magic != IndexMagic || trailer.indexOffset < sizeof(FileHeader) || trailer.indexOffset > indexLimit
+        || trailer.entryCount > (indexLimit - trailer.indexOffset) / sizeof(IndexEntry)
+        || trailer.indexOffset + quint64(trailer.entryCount) * sizeof(IndexEntry) != indexLimit)
+        return false;
+
+    chunks.clear();
+    chunks.reserve(trailer.entryCount);
+    for (quint32 i = 0; i < trailer.entryCount; ++i) {
+        IndexEntry entry;
+        std::memcpy(&entry, mapped + trailer.indexOffset + i * sizeof(IndexEntry), sizeof(entry));
+        Chunk chunk;
+        if (!readChunk(entry.offset, static_cast<qint64>(trailer.indexOffset), chunk))
+            return false;
+        chunks.append(chunk);
+    }
+    return true;
+}
+
+// Odtworzenie indeksu z nagłówków porcji – nagranie przerwane bez stopki
+void ReplaySource::scanChunks(qint64 dataEnd)
+{
+    chunks.clear();
+    quint64 offset = sizeof(FileHeader);
+    Chunk chunk;
+    while (readChunk(offset, dataEnd, chunk)) {
+        chunks.append(chunk);
+        offset += sizeof(ChunkHeader) + quint64(chunk.count) * sizeof(AccSample);
+    }
+}
+
+void ReplaySource::start()
+{
+    if (!chunks.isEmpty() && !running.exchange(true))
+        startRequested = true;
+}
+
+void ReplaySource::stop()
+{
+    running = false;
+}
+
+bool ReplaySource::isRunning() const
+{
+    return running.load();
+}
+
+void ReplaySource::setSpeed(double factor)
+{
+    speed.store(std::max(factor, 0.0));
+    clockRestart = true;
+}
+
+void ReplaySource::seek(qint64 timestamp)
+{
+    pendingSeek = timestamp;
+}
+
+qint64 ReplaySource::firstTimestamp() const
+{
+    return chunks.isEmpty() ? 0 : chunks.first().firstTimestamp;
+}
+
+qint64 ReplaySource::lastTimestamp() const
+{
+    return chunks.isEmpty() ? 0 : chunks.last().lastTimestamp;
+}
+
+qint64 ReplaySource::sampleCount() const
+{
+    return totalSamples;
+}
+
+void ReplaySource::seekTo(qint64 timestamp)
+{
+    // Porcja: pierwsza, której ostatnia próbka nie jest wcześniejsza niż timestamp
+    const auto chunkIt = std::lower_bound(chunks.cbegin(), chunks.cend(), timestamp,
+                                          [](const Chunk& chunk, qint64 ts) { return chunk.lastTimestamp < ts; });
+    chunkPos = static_cast<int>(chunkIt - chunks.cbegin());
+    samplePos = 0;
+    if (chunkIt != chunks.cend()) {
+        const AccSample* begin = chunkIt->samples;
+        const AccSample* end = begin + chunkIt->count;
+        const AccSample* it = std::lower_bound(begin, end, timestamp,
+                                               [](const AccSample& sample, qint64 ts) { return sample.timestamp < ts; });
+        samplePos = static_cast<quint32>(it - begin);
+    }
+}
+
+// Zakotwiczenie zegara odtwarzania w bieżącej pozycji – po starcie, przewinięciu i zmianie prędkości.
+// Znaczniki wyjściowe zaczynają się nie wcześniej niż po ostatnio wysłanej próbce, więc strumień
+// pozostaje monotoniczny także po przewinięciu wstecz.
+void ReplaySource::restartClock(std::int64_t now)
+{
+    wallStart = now;
+    outputStart = std::max<std::int64_t>(now, lastOutput + 1);
+    replayStart = chunkPos < chunks.size() ? chunks[chunkPos].samples[samplePos].timestamp : lastTimestamp();
+}
+
+AccSampleBlock ReplaySource::poll(std::int64_t now)
+{
+    bool anchor = clockRestart.exchange(false);
+    const qint64 seekTarget = pendingSeek.exchange(NoSeek);
+    if (seekTarget != NoSeek) {
+        seekTo(seekTarget);
+        anchor = true;
+    }
+    if (startRequested.exchange(false)) {
+        // Start po dojściu do końca – odtwarzanie od początku
+        if (chunkPos >= chunks.size())
+            seekTo(firstTimestamp());
+        anchor = true;
+    }
+    if (anchor)
+        restartClock(now);
+    if (!running.load())
+        return {};
+
+    const double factor = speed.load();
+    // Znacznik czasu nagrania, do którego należy już wysłać próbki
+    const qint64 target = factor > 0.0
+        ? replayStart + static_cast<qint64>((now - wallStart) * factor)
+        : lastTimestamp();
+    const int maxSamples = factor > 0.0 ? MaxBlockSamples : FastBlockSamples;
+
+    AccSampleBlock block;
+    block.reserve(std::min<qint64>(maxSamples, totalSamples));
+    while (chunkPos < chunks.size() && block.size() < maxSamples) {
+        const Chunk& chunk = chunks[chunkPos];
+        // Próbki czytane prosto z odwzorowanego pliku, kopiowane tylko do bloku wyjściowego.
+        // Znaczniki nagrania pochodzą z zegara innego procesu (i zwykle innego uruchomienia
+        // systemu) – na wyjściu są przeliczane na bieżący zegar: outputStart + (t - replayStart) / speed.
+        // W trybie "najszybciej" odstępy zostają 1:1, a oś czasu wyprzedza zegar.
+        while (samplePos < chunk.count && block.size() < maxSamples
+               && chunk.samples[samplePos].timestamp <= target) {
+            AccSample sample = chunk.samples[samplePos++];
+            const qint64 elapsed = sample.timestamp - replayStart;
+            sample.timestamp = outputStart + (factor > 0.0 ? static_cast<qint64>(elapsed / factor) : elapsed);
+            if (sample.timestamp <= lastOutput)
+                sample.timestamp = lastOutput + 1;
+            lastOutput = sample.timestamp;
+            block.append(sample);
+        }
+        if (samplePos < chunk.count)
+            break;
+        ++chunkPos;
+        samplePos = 0;
+    }
+
+    if (!block.isEmpty())
+        PipelineStats::addSamples(PipelineStats::Stage::Source, block.size());
+
+    if (chunkPos >= chunks.size()) {
+        running = false;
+        emit finished();
+    }
+    return block;
+}
@@ -0,0 +1,201 @@
+#include "serialreader.hpp"
+#include "pipelinestats.hpp"
+#include <QMetaObject>
+#include <QThread>
+#include <algorithm>
+
+SerialWorker::SerialWorker(SerialReader* reader)
+    : m_reader(reader)
+{
+}
+
+// Otwarcie portu – wykonywane już w wątku roboczym, więc QSerialPort należy do tego wątku
+void SerialWorker::open(const QString& portName, qint32 baudRate)
+{
+    close();
+    m_parser.reset();
+    m_clockValid = false;
+
+    m_port = new QSerialPort(this);
+    m_port->setPortName(portName);
+    m_port->setBaudRate(baudRate);
+    m_port->setDataBits(QSerialPort::Data8);
+    m_port->setParity(QSerialPort::NoParity);
+    m_port->setStopBits(QSerialPort::OneStop);
+    m_port->setFlowControl(QSerialPort::NoFlowControl);
+    // Ograniczony bufor odczytu – przy zatorze wolimy tracić stare bajty niż rosnąć bez końca
+    m_port->setReadBufferSize(64 * 1024);
+
+    connect(m_port, &QSerialPort::readyRead, this, &SerialWorker::readPending);
+    connect(m_port, &QSerialPort::errorOccurred, this, &SerialWorker::handleError);
+
+    if (!m_port->open(QIODevice::ReadOnly)) {
+        emit errorOccurred(m_port->errorString());
+        delete m_port;
+        m_port = nullptr;
+        return;
+    }
+    emit opened();
+}
+
+void SerialWorker::close()
+{
+    if (!m_port)
+        return;
+    m_port->close();
+    delete m_port;
+    m_port = nullptr;
+    emit closed();
+}
+
+void SerialWorker::readPending()
+{
+    char chunk[4096];
+    qint64 count;
+    while ((count = m_port->read(chunk, sizeof(chunk))) > 0) {
+        const std::int64_t now = accTimestampNow();
+        m_parser.feed(reinterpret_cast<const std::uint8_t*>(chunk), static_cast<std::size_t>(count),
+                      [this, now](const AccFrame& frame) {
+                          m_reader->pushSample({hostTimestamp(frame.deviceTimeUs, now), frame.x, frame.y, frame.z});
+                      });
+    }
+    m_reader->publishStats(m_parser.stats());
+    m_reader->notifyConsumer();
+}
+
+// Przesunięcie zegarów to najmniejsza zaobserwowana różnica "odczyt - czas urządzenia":
+// ramka nie może dotrzeć przed wysłaniem, więc najszybciej dostarczona ramka wyznacza
+// opóźnienie samego łącza. Przesunięcie powoli podąża w górę, żeby nadążyć za dryfem
+// zegara urządzenia, a skok wstecz czasu urządzenia (restart) zaczyna synchronizację od nowa.
+std::int64_t SerialWorker::hostTimestamp(std::uint32_t deviceTimeUs, std::int64_t arrival)
+{
+    constexpr std::uint32_t HalfRange = 0x80000000u;
+    if (m_clockValid && deviceTimeUs < m_lastDeviceUs) {
+        if (m_lastDeviceUs - deviceTimeUs >= HalfRange)
+            m_deviceBaseUs += std::int64_t(1) << 32;
+        else
+            m_clockValid = false;
+    }
+    if (!m_clockValid)
+        m_deviceBaseUs = 0;
+    m_lastDeviceUs = deviceTimeUs;
+
+    const std::int64_t device = (m_deviceBaseUs + deviceTimeUs) * 1000;
+    const std::int64_t offset = arrival - device;
+    if (!m_clockValid || offset < m_clockOffset) {
+        m_clockOffset = offset;
+        m_clockValid = true;
+    } else {
+        m_clockOffset += (offset - m_clockOffset) / 8192;
+    }
+
+    // Znaczniki strumienia muszą rosnąć – magazyn historii odrzuca powtórzenia
+    m_lastTimestamp = std::max(device + m_clockOffset, m_lastTimestamp + 1);
+    return m_lastTimestamp;
+}
+
+void SerialWorker::handleError(QSerialPort::SerialPortError error)
+{
+    if (error == QSerialPort::NoError)
+        return;
+    emit errorOccurred(m_port->errorString());
+    // Odłączenie urządzenia (lub zamknięcie drugiej strony pty) kończy odczyt
+    if (error == QSerialPort::ResourceError)
+        close();
+}
+
+SerialReader::SerialReader(QObject* parent, std::size_t ringCapacity)
+    : QObject(parent)
+    , m_thread(new QThread(this))
+    , m_worker(new SerialWorker(this))
+    , m_ring(ringCapacity)
+{
+    m_thread->setObjectName("SerialReader");
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+
+    connect(m_worker, &SerialWorker::opened, this, [this]() {
+        m_running = true;
+        emit started();
+    });
+    connect(m_worker, &SerialWorker::closed, this, [this]() {
+        m_running = false;
+        emit stopped();
+    });
+    connect(m_worker, &SerialWorker::errorOccurred, this, &SerialReader::errorOccurred);
+
+    m_thread->start();
+}
+
+SerialReader::~SerialReader()
+{
+    // Zamknięcie portu w jego własnym wątku, potem zakończenie wątku
+    QMetaObject::invokeMethod(m_worker, &SerialWorker::close, Qt::BlockingQueuedConnection);
+    m_thread->quit();
+    m_thread->wait();
+}
+
+void SerialReader::start(const QString& portName, qint32 baudRate)
+{
+    QMetaObject::invokeMethod(m_worker, [this, portName, baudRate]() {
+        m_worker->open(portName, baudRate);
+    }, Qt::QueuedConnection);
+}
+
+void SerialReader::stop()
+{
+    QMetaObject::invokeMethod(m_worker, &SerialWorker::close, Qt::QueuedConnection);
+}
+
+bool SerialReader::isRunning() const
+{
+    return m_running;
+}
+
+std::size_t SerialReader::drain(AccSample* out, std::size_t maxCount)
+{
+    // Najpierw kasujemy flagę, potem opróżniamy – próbka wstawiona w międzyczasie
+    // wygeneruje nowe powiadomienie, więc nic nie utknie w pierścieniu
+    m_notifyPending.store(false, std::memory_order_release);
+    return m_ring.popMany(out, maxCount);
+}
+
+quint64 SerialReader::droppedSamples() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+AccFrameParser::Stats SerialReader::parserStats() const
+{
+    AccFrameParser::Stats stats;
+    stats.frames = m_frames.load(std::memory_order_relaxed);
+    stats.crcErrors = m_crcErrors.load(std::memory_order_relaxed);
+    stats.skippedBytes = m_skippedBytes.load(std::memory_order_relaxed);
+    stats.lostFrames = m_lostFrames.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void SerialReader::pushSample(const AccSample& sample)
+{
+    // Pełny pierścień oznacza, że GUI nie nadąża – odrzucamy najnowszą próbkę i liczymy stratę
+    if (!m_ring.push(sample)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        PipelineStats::addDropped(PipelineStats::Stage::Source, 1);
+    } else {
+        PipelineStats::addSamples(PipelineStats::Stage::Source, 1);
+    }
+}
+
+void SerialReader::notifyConsumer()
+{
+    if (m_ring.size() != 0 && !m_notifyPending.exchange(true, std::memory_order_acq_rel))
+        emit samplesAvailable();
+}
+
+void SerialReader::publishStats(const AccFrameParser::Stats& stats)
+{
+    m_frames.store(stats.frames, std::memory_order_relaxed);
+    m_crcErrors.store(stats.crcErrors, std::memory_order_relaxed);
+    m_skippedBytes.store(stats.skippedBytes, std::memory_order_relaxed);
+    m_lostFrames.store(stats.lostFrames, std::memory_order_relaxed);
+}
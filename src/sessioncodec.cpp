@@ -0,0 +1,330 @@
+#include "sessioncodec.hpp"
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace SessionCodec {
+
+namespace {
+
+using SessionExportFormat::BlockHeader;
+
+inline int leadingZeros(std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    return _BitScanReverse64(&index, value) ? 63 - static_cast<int>(index) : 64;
+#else
+    return value ? __builtin_clzll(value) : 64;
+#endif
+}
+
+inline int trailingZeros(std::uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    return _BitScanForward64(&index, value) ? static_cast<int>(index) : 64;
+#else
+    return value ? __builtin_ctzll(value) : 64;
+#endif
+}
+
+inline std::uint64_t doubleBits(double value)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double bitsDouble(std::uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Zapis bitów od najstarszego; pełne słowa 64-bitowe trafiają do bufora jako 8 bajtów
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+    void write(std::uint64_t value, int bits)
+    {
+        if (bits == 0)
+            return;
+        if (bits < 64)
+            value &= (std::uint64_t(1) << bits) - 1;
+        const int free = 64 - m_used;
+        if (bits < free) {
+            m_word |= value << (free - bits);
+            m_used += bits;
+            return;
+        }
+        const int rest = bits - free;
+        m_word |= value >> rest;
+        flushWord(8);
+        m_word = rest ? value << (64 - rest) : 0;
+        m_used = rest;
+    }
+
+    void finish()
+    {
+        if (m_used > 0)
+            flushWord((m_used + 7) / 8);
+        m_used = 0;
+    }
+
+private:
+    void flushWord(int bytes)
+    {
+        for (int i = 0; i < bytes; ++i)
+            m_out.push_back(static_cast<std::uint8_t>(m_word >> (56 - 8 * i)));
+        m_word = 0;
+    }
+
+    std::vector<std::uint8_t>& m_out;
+    std::uint64_t m_word = 0;
+    int m_used = 0;
+};
+
+class BitReader
+{
+public:
+    BitReader(const std::uint8_t* data, std::size_t size) : m_data(data), m_end(data + size) {}
+
+    std::uint64_t read(int bits)
+    {
+        std::uint64_t result = 0;
+        while (bits > 0) {
+            if (m_available == 0)
+                refill();
+            const int take = bits < m_available ? bits : m_available;
+            const std::uint64_t chunk = (m_buffer >> (m_available - take))
+                                        & (take == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << take) - 1);
+            result = take == 64 ? chunk : (result << take) | chunk;
+            m_available -= take;
+            bits -= take;
+        }
+        return result;
+    }
+
+    // Odczyt poza końcem danych – blok jest uszkodzony
+    bool overrun() const { return m_overrun; }
+
+private:
+    void refill()
+    {
+        m_buffer = 0;
+        int bytes = 0;
+        while (bytes < 8 && m_data < m_end) {
+            m_buffer = (m_buffer << 8) | *m_data++;
+            ++bytes;
+        }
+        if (bytes == 0) {
+            m_overrun = true;
+            m_available = 64;
+            return;
+        }
+        m_available = bytes * 8;
+    }
+
+    const std::uint8_t* m_data;
+    const std::uint8_t* m_end;
+    std::uint64_t m_buffer = 0;
+    int m_available = 0;
+    bool m_overrun = false;
+};
+
+// Kubełki różnicy różnic znaczników [ns]: prefiks i liczba bitów wartości ze znakiem.
+// Próbki co mikrosekundy dają różnice rzędu 1e3..1e6 ns, stąd szersze kubełki niż w Gorilla (sekundy).
+struct DeltaBucket
+{
+    std::uint64_t prefix;
+    int prefixBits;
+    int valueBits;
+};
+constexpr DeltaBucket DeltaBuckets[] = {
+    {0b10, 2, 14},
+    {0b110, 3, 20},
+    {0b1110, 4, 32},
+    {0b1111, 4, 64},
+};
+
+inline bool fitsSigned(std::int64_t value, int bits)
+{
+    if (bits >= 64)
+        return true;
+    const std::int64_t limit = std::int64_t(1) << (bits - 1);
+    return value >= -limit && value < limit;
+}
+
+inline std::int64_t signExtend(std::uint64_t value, int bits)
+{
+    if (bits >= 64)
+        return static_cast<std::int64_t>(value);
+    const std::uint64_t sign = std::uint64_t(1) << (bits - 1);
+    return static_cast<std::int64_t>((value ^ sign) - sign);
+}
+
+// Stan kodowania XOR jednej osi
+struct AxisState
+{
+    std::uint64_t previous = 0;
+    int leading = 64;   ///< Okno bitów znaczących poprzedniej wartości; 64 – brak okna.
+    int trailing = 0;
+};
+
+void encodeValue(BitWriter& writer, AxisState& state, double value)
+{
+    const std::uint64_t bits = doubleBits(value);
+    const std::uint64_t xored = bits ^ state.previous;
+    state.previous = bits;
+    if (xored == 0) {
+        writer.write(0, 1);
+        return;
+    }
+    int leading = leadingZeros(xored);
+    const int trailing = trailingZeros(xored);
+    if (leading > 63)
+        leading = 63;
+    if (state.leading != 64 && leading >= state.leading && trailing >= state.trailing) {
+        // Bity znaczące mieszczą się w oknie poprzedniej wartości
+        writer.write(0b10, 2);
+        writer.write(xored >> state.trailing, 64 - state.leading - state.trailing);
+        return;
+    }
+    const int meaningful = 64 - leading - trailing;
+    writer.write(0b11, 2);
+    writer.write(static_cast<std::uint64_t>(leading), 6);
+    writer.write(static_cast<std::uint64_t>(meaningful - 1), 6);
+    writer.write(xored >> trailing, meaningful);
+    state.leading = leading;
+    state.trailing = trailing;
+}
+
+double decodeValue(BitReader& reader, AxisState& state)
+{
+    if (reader.read(1)) {
+        if (reader.read(1)) {
+            state.leading = static_cast<int>(reader.read(6));
+            const int meaningful = static_cast<int>(reader.read(6)) + 1;
+            state.trailing = 64 - state.leading - meaningful;
+            if (state.trailing < 0) {
+                state.trailing = 0;
+                state.leading = 64;
+                return 0.0;
+            }
+        }
+        const int meaningful = 64 - state.leading - state.trailing;
+        if (meaningful <= 0)
+            return 0.0;
+        state.previous ^= reader.read(meaningful) << state.trailing;
+    }
+    return bitsDouble(state.previous);
+}
+
+} // namespace
+
+void encodeBlock(std::uint32_t streamId, const AccSample* samples, std::size_t count,
+                 std::vector<std::uint8_t>& out)
+{
+    if (count == 0)
+        return;
+
+    // Nagłówek jest uzupełniany po zakodowaniu danych, gdy znana jest ich długość
+    const std::size_t headerPos = out.size();
+    out.resize(headerPos + sizeof(BlockHeader));
+    const std::size_t payloadPos = out.size();
+
+    BitWriter writer(out);
+    AxisState axes[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        const double value = axis == 0 ? samples[0].x : axis == 1 ? samples[0].y : samples[0].z;
+        axes[axis].previous = doubleBits(value);
+        writer.write(axes[axis].previous, 64);
+    }
+
+    std::int64_t previousDelta = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        const std::int64_t delta = samples[i].timestamp - samples[i - 1].timestamp;
+        const std::int64_t deltaOfDelta = delta - previousDelta;
+        previousDelta = delta;
+        if (deltaOfDelta == 0) {
+            writer.write(0, 1);
+        } else {
+            for (const DeltaBucket& bucket : DeltaBuckets) {
+                if (fitsSigned(deltaOfDelta, bucket.valueBits)) {
+                    writer.write(bucket.prefix, bucket.prefixBits);
+                    writer.write(static_cast<std::uint64_t>(deltaOfDelta), bucket.valueBits);
+                    break;
+                }
+            }
+        }
+        encodeValue(writer, axes[0], samples[i].x);
+        encodeValue(writer, axes[1], samples[i].y);
+        encodeValue(writer, axes[2], samples[i].z);
+    }
+    writer.finish();
+    out.resize(payloadPos + ((out.size() - payloadPos + 7) & ~std::size_t(7)), 0);
+
+    BlockHeader header;
+    header.magic = SessionExportFormat::BlockMagic;
+    header.streamId = streamId;
+    header.count = static_cast<std::uint32_t>(count);
+    header.payloadBytes = static_cast<std::uint32_t>(out.size() - payloadPos);
+    header.firstTimestamp = samples[0].timestamp;
+    header.lastTimestamp = samples[count - 1].timestamp;
+    std::memcpy(out.data() + headerPos, &header, sizeof(header));
+}
+
+bool decodeBlock(const std::uint8_t* data, std::size_t size, SessionExportFormat::BlockHeader& header,
+                 std::vector<AccSample>& out, std::size_t& consumed)
+{
+    out.clear();
+    if (size < sizeof(BlockHeader))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != SessionExportFormat::BlockMagic || header.count == 0
+        || header.payloadBytes % 8 != 0 || header.payloadBytes > size - sizeof(BlockHeader))
+        return false;
+    // Liczba próbek pochodzi z pliku: pierwsza zajmuje 192 bity, każda następna co najmniej 4
+    // (bit znacznika czasu i po bicie na oś) – większa nie mieści się w ładunku, a resize() alokowałby na ślepo
+    const std::uint64_t payloadBits = std::uint64_t(header.payloadBytes) * 8;
+    if (payloadBits < 192 || header.count - 1 > (payloadBits - 192) / 4)
+        return false;
+
+    BitReader reader(data + sizeof(BlockHeader), header.payloadBytes);
+    out.resize(header.count);
+    AxisState axes[3];
+    for (AxisState& axis : axes)
+        axis.previous = reader.read(64);
+    out[0] = {header.firstTimestamp, bitsDouble(axes[0].previous), bitsDouble(axes[1].previous),
+              bitsDouble(axes[2].previous)};
+
+    std::int64_t timestamp = header.firstTimestamp;
+    std::int64_t delta = 0;
+    for (std::uint32_t i = 1; i < header.count && !reader.overrun(); ++i) {
+        if (reader.read(1)) {
+            int bucket = 0;
+            while (bucket < 3 && reader.read(1))
+                ++bucket;
+            const int bits = DeltaBuckets[bucket].valueBits;
+            delta += signExtend(reader.read(bits), bits);
+        }
+        timestamp += delta;
+        const double x = decodeValue(reader, axes[0]);
+        const double y = decodeValue(reader, axes[1]);
+        const double z = decodeValue(reader, axes[2]);
+        out[i] = {timestamp, x, y, z};
+    }
+    if (reader.overrun() || timestamp != header.lastTimestamp) {
+        out.clear();
+        return false;
+    }
+    consumed = sizeof(BlockHeader) + header.payloadBytes;
+    return true;
+}
+
+} // namespace SessionCodec
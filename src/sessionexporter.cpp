@@ -0,0 +1,213 @@
+#include "sessionexporter.hpp"
+#include <QMutexLocker>
+#include <QThread>
+#include <cstring>
+
+SessionExporter::SessionExporter(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SessionExporter::~SessionExporter()
+{
+    stop();
+}
+
+bool SessionExporter::start(const QString& path)
+{
+    if (isExporting())
+        return false;
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = file.errorString();
+        return false;
+    }
+
+    SessionExportFormat::FileHeader header;
+    std::memcpy(header.magic, SessionExportFormat::FileMagic, sizeof(header.magic));
+    header.version = SessionExportFormat::Version;
+    header.reserved = 0;
+    if (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header)) {
+        error = file.errorString();
+        file.close();
+        return false;
+    }
+
+    buffers.clear();
+    stopRequested = false;
+    pendingSamples = 0;
+    failed = false;
+    exported = 0;
+    dropped = 0;
+    bytes = sizeof(header);
+
+    writerThread = QThread::create([this]() { writerLoop(); });
+    writerThread->setObjectName("SessionExporter");
+    writerThread->start(QThread::LowPriority);
+    {
+        QMutexLocker locker(&mutex);
+        accepting = true;
+    }
+    return true;
+}
+
+void SessionExporter::stop()
+{
+    if (!writerThread)
+        return;
+    {
+        QMutexLocker locker(&mutex);
+        stopRequested = true;
+        accepting = false;
+    }
+    wake.wakeOne();
+    writerThread->wait();
+    delete writerThread;
+    writerThread = nullptr;
+}
+
+bool SessionExporter::isExporting() const
+{
+    return writerThread != nullptr;
+}
+
+QString SessionExporter::errorString() const
+{
+    QMutexLocker locker(&mutex);
+    return error;
+}
+
+quint64 SessionExporter::exportedSamples() const
+{
+    return exported.load(std::memory_order_relaxed);
+}
+
+quint64 SessionExporter::droppedSamples() const
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+quint64 SessionExporter::bytesWritten() const
+{
+    return bytes.load(std::memory_order_relaxed);
+}
+
+// Wywoływane w wątkach puli (połączenie bezpośrednie) – tylko odłożenie uchwytu bloku do kolejki
+void SessionExporter::record(int streamId, const AccSampleBlock& block)
+{
+    if (block.isEmpty())
+        return;
+    {
+        QMutexLocker locker(&mutex);
+        if (!accepting)
+            return;
+        if (failed.load(std::memory_order_relaxed) || pendingSamples + block.size() > MaxPendingSamples) {
+            dropped.fetch_add(static_cast<quint64>(block.size()), std::memory_order_relaxed);
+            return;
+        }
+        pending.append(qMakePair(streamId, block));
+        pendingSamples += block.size();
+    }
+    wake.wakeOne();
+}
+
+void SessionExporter::writerLoop()
+{
+    QVector<QPair<int, AccSampleBlock>> batch;
+    bool finishing = false;
+    while (!finishing && !failed.load()) {
+        {
+            QMutexLocker locker(&mutex);
+            if (pending.isEmpty() && !stopRequested) {
+                // Brak nowych danych przez FlushIntervalMs – niepełne bloki idą na dysk
+                if (!wake.wait(&mutex, FlushIntervalMs) && pending.isEmpty()) {
+                    locker.unlock();
+                    writeBuffers();
+                    flushFile();
+                    continue;
+                }
+            }
+            batch.swap(pending);
+            pendingSamples = 0;
+            finishing = stopRequested;
+        }
+
+        for (const QPair<int, AccSampleBlock>& entry : batch)
+            append(entry.first, entry.second);
+        batch.clear();
+    }
+
+    writeBuffers();
+    flushFile();
+    file.close();
+}
+
+// Zapis w całości albo przerwanie eksportu
+bool SessionExporter::writeAll(const void* data, qint64 size)
+{
+    if (failed.load())
+        return false;
+    if (file.write(static_cast<const char*>(data), size) == size)
+        return true;
+    fail(file.errorString());
+    return false;
+}
+
+// QFile buforuje małe zapisy, więc brak miejsca może wyjść dopiero przy opróżnianiu bufora
+bool SessionExporter::flushFile()
+{
+    if (failed.load())
+        return false;
+    if (file.flush())
+        return true;
+    fail(file.errorString());
+    return false;
+}
+
+// Zapamiętanie błędu i zakończenie pracy wątku zapisu; zaległe bloki są liczone jako odrzucone
+void SessionExporter::fail(const QString& message)
+{
+    {
+        QMutexLocker locker(&mutex);
+        error = message;
+        failed = true;
+        dropped.fetch_add(static_cast<quint64>(pendingSamples), std::memory_order_relaxed);
+        pending.clear();
+        pendingSamples = 0;
+    }
+    emit writeFailed(message);
+}
+
+void SessionExporter::append(int streamId, const AccSampleBlock& block)
+{
+    std::vector<AccSample>& buffer = buffers[streamId];
+    if (buffer.capacity() < BlockSamples)
+        buffer.reserve(BlockSamples);
+    for (const AccSample& sample : block) {
+        buffer.push_back(sample);
+        if (buffer.size() == BlockSamples)
+            writeBlock(streamId, buffer);
+    }
+}
+
+void SessionExporter::writeBlock(int streamId, std::vector<AccSample>& samples)
+{
+    if (samples.empty())
+        return;
+    encoded.clear();
+    SessionCodec::encodeBlock(static_cast<std::uint32_t>(streamId), samples.data(), samples.size(), encoded);
+    if (writeAll(encoded.data(), static_cast<qint64>(encoded.size()))) {
+        exported.fetch_add(samples.size(), std::memory_order_relaxed);
+        bytes.fetch_add(encoded.size(), std::memory_order_relaxed);
+    } else {
+        dropped.fetch_add(samples.size(), std::memory_order_relaxed);
+    }
+    samples.clear();
+}
+
+void SessionExporter::writeBuffers()
+{
+    for (auto& entry : buffers)
+        writeBlock(entry.first, entry.second);
+}
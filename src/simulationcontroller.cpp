@@ -1,32 +1,483 @@
 #include "simulationcontroller.hpp"
 #include "accsimulator.hpp"
+#include "externalsource.hpp"
+#include "filterstage.hpp"
+#include "intervaltracker.hpp"
+#include "pipelinestats.hpp"
+#include "telemetryshm.hpp"
+#include "workstealingpool.hpp"
+#include <QMetaObject>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+// Źródło jest obiektem wątku GUI; zwolnione w innym wątku (ostatnie zadanie puli) – usuwane przez deleteLater
+std::shared_ptr<SampleSource> adoptSource(SampleSource* source)
+{
+    source->setParent(nullptr);
+    return std::shared_ptr<SampleSource>(source, [](SampleSource* s) {
+        if (s->thread() == QThread::currentThread())
+            delete s;
+        else
+            s->deleteLater();
+    });
+}
+}
+
+struct SimulationController::Stream
+{
+    int id;
+    QString name;
+    std::mutex mutex;                       ///< Chroni source.
+    std::shared_ptr<SampleSource> source;
+    FilterStage filter;
+    IntervalTracker interval;               ///< Odstępy między próbkami; używany tylko przez zadanie puli.
+    EventDetector detector;
+    std::atomic<bool> busy{false};          ///< Strumień jest właśnie obsługiwany przez pulę.
+    std::atomic<bool> retime{false};        ///< Zmiana źródła lub częstotliwości – odstęp do wyznaczenia od nowa.
+    std::mutex shmMutex;                    ///< Chroni shmPending (zadanie puli strumienia i harmonogram).
+    std::vector<AccSampleBlock> shmPending; ///< Bloki po filtracji czekające na publikację w pierścieniu.
+
+    bool active()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return source && source->isRunning();
+    }
+};
 
 SimulationController::SimulationController(QObject *parent)
     : QObject(parent)
 {
-    // Tworzenie instancji symulatora akcelerometru
-    simulator = new AccSimulator(this);
+    // Rejestracja typu bloku dla połączeń kolejkowanych między wątkami
+    qRegisterMetaType<AccSampleBlock>("AccSampleBlock");
+    qRegisterMetaType<EventDetector::Event>("EventDetector::Event");
+    rules = std::make_shared<const EventDetector::RuleSet>(EventDetector::defaultRules());
 
-    // Połączenie sygnału newData z symulatora z metodą emitującą ten sygnał z klasy SimulationController
-    connect(simulator, &AccSimulator::newData, this, [this](double x, double y, double z) {
-        emit newData(x, y, z);  // Emitowanie nowego sygnału z danymi (x, y, z)
-    });
+    // Strumień 0 z wbudowanym symulatorem akcelerometru – domyślne źródło danych
+    addStream(nullptr, QString());
+    setSource(nullptr);
+
+    pool = std::make_unique<WorkStealingPool>();
+    scheduler = std::thread([this]() { schedulerLoop(); });
+}
+
+SimulationController::~SimulationController()
+{
+    // Najpierw harmonogram, potem pula (dokończenie zleconych zadań), na końcu źródła
+    stopping = true;
+    scheduler.join();
+    pool.reset();
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    streams.clear();
+}
+
+int SimulationController::addStream(SampleSource* source, const QString& name)
+{
+    auto stream = std::make_shared<Stream>();
+    if (source)
+        stream->source = adoptSource(source);
+    {
+        std::lock_guard<std::mutex> lock(streamsMutex);
+        stream->id = nextStreamId++;
+        stream->name = name.isEmpty() ? QString("Stream %1").arg(stream->id) : name;
+        stream->detector.setRules(rules);
+        streams.push_back(stream);
+    }
+    emit streamAdded(stream->id, stream->name);
+    return stream->id;
+}
+
+std::shared_ptr<SimulationController::Stream> SimulationController::findStream(int id) const
+{
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    const auto it = std::find_if(streams.cbegin(), streams.cend(),
+                                 [id](const std::shared_ptr<Stream>& stream) { return stream->id == id; });
+    return it != streams.cend() ? *it : nullptr;
+}
+
+void SimulationController::setSource(SampleSource* newSource)
+{
+    if (!newSource) {
+        AccSimulator* simulator = new AccSimulator();
+        simulator->setSampleRate(rate.load());
+        simulator->setSeed(baseSeed.load() + PrimaryStream);
+        newSource = simulator;
+    }
+
+    const std::shared_ptr<Stream> stream = findStream(PrimaryStream);
+    std::shared_ptr<SampleSource> previous;
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        previous = std::move(stream->source);
+        stream->source = adoptSource(newSource);
+    }
+    stream->retime = true;
+    if (previous) {
+        previous->stop();
+        disconnect(previous.get(), nullptr, this, nullptr);
+    }
+    connect(newSource, &SampleSource::finished, this, &SimulationController::sourceFinished);
+}
+
+int SimulationController::addSource(SampleSource* source, const QString& name)
+{
+    return addStream(source, name);
+}
+
+void SimulationController::removeSource(int id)
+{
+    if (id == PrimaryStream)
+        return;
+    std::shared_ptr<Stream> removed;
+    {
+        std::lock_guard<std::mutex> lock(streamsMutex);
+        const auto it = std::find_if(streams.begin(), streams.end(),
+                                     [id](const std::shared_ptr<Stream>& stream) { return stream->id == id; });
+        if (it == streams.end())
+            return;
+        removed = *it;
+        streams.erase(it);
+    }
+    simulatedIds.erase(std::remove(simulatedIds.begin(), simulatedIds.end(), id), simulatedIds.end());
+    {
+        std::lock_guard<std::mutex> lock(removed->mutex);
+        if (removed->source)
+            removed->source->stop();
+    }
+    // Zadanie puli mogło jeszcze wystawić blok tego strumienia – odbiorcy ignorują nieznane id
+    emit streamRemoved(id);
+}
+
+void SimulationController::setSimulatedStreams(int count)
+{
+    count = std::max(count, 1);
+    while (static_cast<int>(simulatedIds.size()) + 1 < count) {
+        // Każdy czujnik ma własne ziarno: ziarno bazowe + identyfikator strumienia
+        AccSimulator* simulator = new AccSimulator();
+        simulator->setSampleRate(rate.load());
+        simulator->setSeed(baseSeed.load() + static_cast<quint64>(nextStreamId));
+        if (isRunning())
+            simulator->start();
+        simulatedIds.push_back(addStream(simulator, QString()));
+    }
+    while (static_cast<int>(simulatedIds.size()) + 1 > count)
+        removeSource(simulatedIds.back());
+}
+
+QList<int> SimulationController::streamIds() const
+{
+    QList<int> ids;
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    for (const std::shared_ptr<Stream>& stream : streams)
+        ids.append(stream->id);
+    return ids;
+}
+
+QString SimulationController::streamName(int id) const
+{
+    const std::shared_ptr<Stream> stream = findStream(id);
+    return stream ? stream->name : QString();
+}
+
+std::size_t SimulationController::workerCount() const
+{
+    return pool->threadCount();
+}
+
+// Wątek harmonogramu: co takt jedno zadanie puli na każdy aktywny strumień.
+// Strumień, którego poprzedni takt jeszcze trwa, jest pomijany – źródła liczą
+// zaległe próbki z czasu, więc kolejny takt odda je w jednym bloku.
+// Takty mają bezwzględne terminy (sleep_until), więc czas obsługi i spóźnione
+// wybudzenia nie przesuwają kolejnych taktów, jak przy sleep_for.
+void SimulationController::schedulerLoop()
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration period = std::chrono::milliseconds(TickMs);
+    std::vector<std::shared_ptr<Stream>> snapshot;
+    Clock::time_point deadline = Clock::now();
+    while (!stopping.load()) {
+        const std::int64_t now = accTimestampNow();
+        PipelineStats::record(PipelineStats::Stage::Tick,
+                              now - std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count());
+        {
+            std::lock_guard<std::mutex> lock(streamsMutex);
+            snapshot = streams;
+        }
+        publishShared(snapshot);
+        for (const std::shared_ptr<Stream>& stream : snapshot) {
+            if (!stream->active() || stream->busy.exchange(true))
+                continue;
+            pool->submit([this, stream, now]() {
+                runStream(*stream, now);
+            });
+        }
+        snapshot.clear();
+
+        // Po długim zatrzymaniu wątku zaległe takty są pomijane, a nie nadrabiane serią
+        deadline += period;
+        const Clock::duration late = Clock::now() - deadline;
+        if (late >= period) {
+            const auto missed = late / period;
+            deadline += missed * period;
+            PipelineStats::addCoalesced(PipelineStats::Stage::Tick, missed);
+        }
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+// Wątek harmonogramu jest jedynym pisarzem pierścienia: co takt publikuje bloki odłożone przez
+// zadania puli od poprzedniego taktu. Kopiowanie do pamięci współdzielonej nie blokuje zadań,
+// a shmMutex chroni tylko podmianę pisarza w startSharedMemory()/stopSharedMemory().
+void SimulationController::publishShared(const std::vector<std::shared_ptr<Stream>>& snapshot)
+{
+    std::lock_guard<std::mutex> lock(shmMutex);
+    for (const std::shared_ptr<Stream>& stream : snapshot) {
+        {
+            std::lock_guard<std::mutex> streamLock(stream->shmMutex);
+            shmBlocks.swap(stream->shmPending);
+        }
+        if (shmWriter) {
+            for (const AccSampleBlock& block : shmBlocks)
+                shmWriter->publish(static_cast<std::uint32_t>(stream->id), block.constData(),
+                                   static_cast<std::size_t>(block.size()));
+        }
+        shmBlocks.clear();
+    }
+}
+
+// Jeden takt strumienia w wątku puli: źródło -> wykrywanie zdarzeń -> filtracja -> magazyn/eksport i skrzynka wątku GUI
+void SimulationController::runStream(Stream& stream, std::int64_t now)
+{
+    std::shared_ptr<SampleSource> source;
+    {
+        std::lock_guard<std::mutex> lock(stream.mutex);
+        source = stream.source;
+    }
+
+    // Jedno źródło na strumień – bloki nigdy nie łączą próbek z dwóch zegarów
+    AccSampleBlock block;
+    if (source) {
+        block = source->poll(now);
+        if (!block.isEmpty() && stream.id == PrimaryStream)
+            emit rawBlock(block);
+    }
+
+    // Po zmianie źródła lub częstotliwości pierwszy odstęp nie jest przerwą – oba trackery
+    // (tu i w magazynie) zaczynają od nowa, zanim dotrze pierwszy blok nowego taktowania
+    if (stream.retime.exchange(false)) {
+        stream.interval.reset();
+        emit intervalReset(stream.id);
+    }
+
+    // Regularność znaczników czasu: odchylenie od nominalnego odstępu i próbki brakujące w przerwach
+    for (const AccSample& sample : block) {
+        const IntervalTracker::Step step = stream.interval.observe(sample.timestamp);
+        if (step.gapNs > 0)
+            PipelineStats::addDropped(PipelineStats::Stage::Interval, step.gapNs / stream.interval.interval() - 1);
+        else
+            PipelineStats::record(PipelineStats::Stage::Interval, step.deviationNs, 1);
+    }
+
+    if (!block.isEmpty()) {
+        // Reguły działają na surowych próbkach – filtr (np. usuwający grawitację) zmieniałby ich sens
+        std::vector<EventDetector::Event> events;
+        stream.detector.process(block.constData(), static_cast<std::size_t>(block.size()), events);
+        if (stream.detector.isEnabled())
+            PipelineStats::addSamples(PipelineStats::Stage::Detect, block.size());
+
+        const AccSampleBlock filtered = stream.filter.process(block);
+        const int id = stream.id;
+
+        // Do pierścienia pisze tylko harmonogram – zadanie odkłada jedynie uchwyt bloku
+        if (shmActive.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(stream.shmMutex);
+            stream.shmPending.push_back(filtered);
+        }
+
+        // Magazyn i eksport dostają blok jeszcze w wątku puli; wątek GUI – tylko zbiorcze powiadomienie
+        emit streamBlock(id, filtered);
+        postToGui(id, filtered, events);
+    }
+
+    // Zwolnienie strumienia dopiero po przekazaniu bloku – bloki strumienia nie wyprzedzają się
+    stream.busy.store(false, std::memory_order_release);
+}
+
+// Dokłada blok do skrzynki wątku GUI; zdarzenie kolejki jest wystawiane tylko wtedy, gdy poprzednie
+// zostało już odebrane, więc przy N strumieniach wątek GUI nadal budzi się najwyżej raz na takt.
+// Próbki strumienia 0 z kolejnych bloków są łączone – zachowują kolejność, bo strumień jest obsługiwany
+// przez jedno zadanie naraz.
+void SimulationController::postToGui(int id, const AccSampleBlock& filtered,
+                                     const std::vector<EventDetector::Event>& events)
+{
+    {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        if (id == PrimaryStream) {
+            if (outbox.primary.isEmpty())
+                outbox.primary = filtered;
+            else
+                outbox.primary += filtered;
+        }
+        for (const EventDetector::Event& event : events)
+            outbox.events.emplace_back(id, event);
+        outbox.blocks.emplace_back(filtered.first().timestamp, static_cast<int>(filtered.size()));
+        if (outbox.posted)
+            return;
+        outbox.posted = true;
+    }
+    // Pomiar kolejki: wejście liczone w wątku puli, wyjście i wiek najstarszej próbki każdego
+    // bloku – po odebraniu w wątku GUI
+    PipelineStats::queueEnter(PipelineStats::Stage::Dispatch);
+    QMetaObject::invokeMethod(this, [this]() { deliverToGui(); }, Qt::QueuedConnection);
+}
+
+void SimulationController::deliverToGui()
+{
+    Outbox delivered;
+    {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        std::swap(delivered, outbox);
+    }
+    PipelineStats::queueLeave(PipelineStats::Stage::Dispatch);
+    const std::int64_t received = accTimestampNow();
+    for (const std::pair<std::int64_t, int>& block : delivered.blocks)
+        PipelineStats::record(PipelineStats::Stage::Dispatch, received - block.first, block.second);
+    if (!delivered.primary.isEmpty())
+        emit newBlock(delivered.primary);
+    for (const std::pair<int, EventDetector::Event>& event : delivered.events) {
+        PipelineStats::record(PipelineStats::Stage::Detect, received - event.second.timestamp);
+        emit detectorEvent(event.first, event.second);
+    }
+}
+
+bool SimulationController::startSharedMemory(const QString& name, QString* error)
+{
+    auto writer = std::make_unique<TelemetryShm::Writer>();
+    if (!writer->open(name.toStdString())) {
+        if (error)
+            *error = QString::fromStdString(writer->errorString());
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(shmMutex);
+    shmWriter = std::move(writer);
+    shmActive = true;
+    return true;
+}
+
+void SimulationController::stopSharedMemory()
+{
+    std::lock_guard<std::mutex> lock(shmMutex);
+    shmActive = false;
+    shmWriter.reset();
+}
+
+bool SimulationController::isSharingMemory() const
+{
+    return shmActive.load();
 }
 
 // Funkcja rozpoczynająca symulację
 void SimulationController::startSimulation()
 {
-    simulator->start();  // Uruchomienie symulatora
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    for (const std::shared_ptr<Stream>& stream : streams) {
+        std::lock_guard<std::mutex> streamLock(stream->mutex);
+        if (stream->source)
+            stream->source->start();  // Uruchomienie źródła danych
+    }
 }
 
 // Funkcja zatrzymująca symulację
 void SimulationController::stopSimulation()
 {
-    simulator->stop();  // Zatrzymanie symulatora
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    for (const std::shared_ptr<Stream>& stream : streams) {
+        std::lock_guard<std::mutex> streamLock(stream->mutex);
+        if (stream->source)
+            stream->source->stop();  // Zatrzymanie źródła danych
+    }
 }
 
-// Funkcja sprawdzająca, czy symulacja jest aktywna
+// Funkcja sprawdzająca, czy symulacja jest aktywna (stan źródła strumienia 0)
 bool SimulationController::isRunning() const
 {
-    return simulator->isRunning();  // Zwrócenie stanu symulacji (czy jest uruchomiona)
+    const std::shared_ptr<Stream> stream = findStream(PrimaryStream);
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    return stream->source && stream->source->isRunning();
+}
+
+void SimulationController::setSampleRate(double hz)
+{
+    rate.store(std::clamp(hz, 0.1, AccSimulator::MaxSampleRate));
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    for (const std::shared_ptr<Stream>& stream : streams) {
+        std::lock_guard<std::mutex> streamLock(stream->mutex);
+        if (AccSimulator* simulator = qobject_cast<AccSimulator*>(stream->source.get())) {
+            simulator->setSampleRate(hz);
+            stream->retime = true;
+        }
+    }
+}
+
+// Ziarno bazowe symulatorów; strumień n dostaje ziarno seed + n
+void SimulationController::setSeed(quint64 seed)
+{
+    baseSeed.store(seed);
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    for (const std::shared_ptr<Stream>& stream : streams) {
+        std::lock_guard<std::mutex> streamLock(stream->mutex);
+        if (AccSimulator* simulator = qobject_cast<AccSimulator*>(stream->source.get()))
+            simulator->setSeed(seed + static_cast<quint64>(stream->id));
+    }
+}
+
+quint64 SimulationController::seed() const
+{
+    return baseSeed.load();
+}
+
+double SimulationController::sampleRate() const
+{
+    return rate.load();
+}
+
+quint64 SimulationController::droppedSamples() const
+{
+    quint64 total = 0;
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    for (const std::shared_ptr<Stream>& stream : streams) {
+        std::lock_guard<std::mutex> streamLock(stream->mutex);
+        if (AccSimulator* simulator = qobject_cast<AccSimulator*>(stream->source.get()))
+            total += simulator->droppedSamples();
+    }
+    return total;
+}
+
+void SimulationController::setFilterChain(int streamId, std::shared_ptr<dsp::FilterChain> chain)
+{
+    if (const std::shared_ptr<Stream> stream = findStream(streamId))
+        stream->filter.setChain(std::move(chain));
+}
+
+void SimulationController::setEventRules(std::shared_ptr<const EventDetector::RuleSet> newRules)
+{
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    rules = std::move(newRules);
+    for (const std::shared_ptr<Stream>& stream : streams)
+        stream->detector.setRules(rules);
+}
+
+std::shared_ptr<const EventDetector::RuleSet> SimulationController::eventRules() const
+{
+    std::lock_guard<std::mutex> lock(streamsMutex);
+    return rules;
+}
+
+void SimulationController::pushExternalBlock(const AccSampleBlock& block)
+{
+    const std::shared_ptr<Stream> stream = findStream(PrimaryStream);
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (ExternalSource* external = qobject_cast<ExternalSource*>(stream->source.get()))
+        external->push(block);
 }
@@ -0,0 +1,101 @@
+#include "slidingfft.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace dsp {
+
+namespace {
+constexpr double Pi = 3.14159265358979323846;
+}
+
+SlidingFft::SlidingFft(std::size_t size, std::size_t hop)
+{
+    // Zaokrąglenie do potęgi dwójki (minimum 16 punktów)
+    m_size = 16;
+    while (m_size < size)
+        m_size <<= 1;
+    m_hop = hop == 0 ? m_size / 2 : std::min(hop, m_size);
+
+    m_window.resize(m_size);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < m_size; ++i) {
+        m_window[i] = 0.5 - 0.5 * std::cos(2.0 * Pi * static_cast<double>(i) / static_cast<double>(m_size));
+        sum += m_window[i];
+    }
+    // Skalowanie: sinusoida o amplitudzie A daje prążek o wartości A
+    m_windowGain = 2.0 / sum;
+
+    m_twiddles.resize(m_size / 2);
+    for (std::size_t k = 0; k < m_size / 2; ++k)
+        m_twiddles[k] = std::polar(1.0, -2.0 * Pi * static_cast<double>(k) / static_cast<double>(m_size));
+
+    unsigned bits = 0;
+    while ((std::size_t(1) << bits) < m_size)
+        ++bits;
+    m_bitReverse.resize(m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+        std::uint32_t reversed = 0;
+        for (unsigned b = 0; b < bits; ++b)
+            if (i & (std::size_t(1) << b))
+                reversed |= 1u << (bits - 1 - b);
+        m_bitReverse[i] = reversed;
+    }
+
+    m_history.assign(m_size, 0.0);
+    m_work.resize(m_size);
+    m_magnitudes.assign(bins(), 0.0f);
+}
+
+void SlidingFft::reset()
+{
+    std::fill(m_history.begin(), m_history.end(), 0.0);
+    std::fill(m_magnitudes.begin(), m_magnitudes.end(), 0.0f);
+    m_pos = 0;
+    m_filled = 0;
+    m_sinceLast = 0;
+}
+
+bool SlidingFft::push(double value)
+{
+    m_history[m_pos] = value;
+    m_pos = (m_pos + 1) & (m_size - 1);
+    if (m_filled < m_size)
+        ++m_filled;
+    if (++m_sinceLast < m_hop || m_filled < m_size)
+        return false;
+    m_sinceLast = 0;
+    compute();
+    return true;
+}
+
+void SlidingFft::compute()
+{
+    // Okienkowanie z usunięciem składowej stałej; od razu w kolejności odwróconych bitów
+    double mean = 0.0;
+    for (double value : m_history)
+        mean += value;
+    mean /= static_cast<double>(m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+        const double sample = m_history[(m_pos + i) & (m_size - 1)] - mean;
+        m_work[m_bitReverse[i]] = std::complex<double>(sample * m_window[i], 0.0);
+    }
+
+    // Iteracyjna FFT radix-2 (decymacja w czasie)
+    for (std::size_t len = 2; len <= m_size; len <<= 1) {
+        const std::size_t half = len / 2;
+        const std::size_t stride = m_size / len;
+        for (std::size_t start = 0; start < m_size; start += len) {
+            for (std::size_t k = 0; k < half; ++k) {
+                const std::complex<double> t = m_twiddles[k * stride] * m_work[start + k + half];
+                const std::complex<double> u = m_work[start + k];
+                m_work[start + k] = u + t;
+                m_work[start + k + half] = u - t;
+            }
+        }
+    }
+
+    for (std::size_t k = 0; k < bins(); ++k)
+        m_magnitudes[k] = static_cast<float>(std::abs(m_work[k]) * m_windowGain);
+}
+
+} // namespace dsp
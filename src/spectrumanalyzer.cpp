@@ -0,0 +1,59 @@
+#include "spectrumanalyzer.hpp"
+#include <QMetaObject>
+#include <cmath>
+
+SpectrumAnalyzer::SpectrumAnalyzer(QObject *parent)
+    : QObject(parent)
+    , m_fft(new dsp::SlidingFft(1024))
+{
+    qRegisterMetaType<SpectrumFrame>("SpectrumFrame");
+}
+
+void SpectrumAnalyzer::configure(int fftSize, Channel channel)
+{
+    QMetaObject::invokeMethod(this, [this, fftSize, channel]() {
+        apply(fftSize, channel);
+    }, Qt::AutoConnection);
+}
+
+void SpectrumAnalyzer::apply(int fftSize, Channel channel)
+{
+    m_fft.reset(new dsp::SlidingFft(static_cast<std::size_t>(fftSize)));
+    m_channel = channel;
+    m_lastFrameTime = 0;
+    m_samplesSinceFrame = 0;
+}
+
+void SpectrumAnalyzer::process(const AccSampleBlock& block)
+{
+    for (const AccSample &sample : block) {
+        double value;
+        switch (m_channel) {
+        case Channel::X: value = sample.x; break;
+        case Channel::Y: value = sample.y; break;
+        case Channel::Z: value = sample.z; break;
+        default: value = std::sqrt(sample.x * sample.x + sample.y * sample.y + sample.z * sample.z); break;
+        }
+        ++m_samplesSinceFrame;
+        if (!m_fft->push(value))
+            continue;
+
+        // Częstotliwość próbkowania z odstępu między ramkami (wygładzana)
+        if (m_lastFrameTime != 0 && sample.timestamp > m_lastFrameTime) {
+            const double rate = m_samplesSinceFrame * 1e9 / static_cast<double>(sample.timestamp - m_lastFrameTime);
+            m_sampleRate = m_sampleRate > 0.0 ? 0.8 * m_sampleRate + 0.2 * rate : rate;
+        }
+        m_lastFrameTime = sample.timestamp;
+        m_samplesSinceFrame = 0;
+        if (m_sampleRate <= 0.0)
+            continue;
+
+        // Nowy wektor na każdą ramkę – odbiorca dostaje go bez kopiowania, analizator go już nie rusza
+        SpectrumFrame frame;
+        frame.timestamp = sample.timestamp;
+        frame.binHz = m_sampleRate / static_cast<double>(m_fft->size());
+        const std::vector<float> &magnitudes = m_fft->magnitudes();
+        frame.magnitudes = QVector<float>(magnitudes.begin(), magnitudes.end());
+        emit frameReady(frame);
+    }
+}
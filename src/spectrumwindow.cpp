@@ -0,0 +1,158 @@
+#include "spectrumwindow.hpp"
+#include <QHBoxLayout>
+#include <QPainter>
+#include <QPainterPath>
+#include <QThread>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <cmath>
+
+SpectrumView::SpectrumView(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumSize(400, 300);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    // Paleta: granat -> niebieski -> żółty -> czerwony
+    for (int i = 0; i < 256; ++i) {
+        const double t = i / 255.0;
+        const int r = static_cast<int>(255 * std::clamp(2.0 * t - 0.5, 0.0, 1.0));
+        const int g = static_cast<int>(255 * std::clamp(1.5 - std::abs(3.0 * t - 1.5), 0.0, 1.0));
+        const int b = static_cast<int>(255 * std::clamp(1.0 - 2.0 * t, 0.2, 1.0) * (t < 0.05 ? t * 20.0 : 1.0));
+        palette[i] = qRgb(r, g, b);
+    }
+}
+
+QRgb SpectrumView::colorFor(float magnitude) const
+{
+    const float db = 20.0f * std::log10(magnitude + 1e-6f);
+    const float t = std::clamp((db - minDb) / (maxDb - minDb), 0.0f, 1.0f);
+    return palette[static_cast<int>(t * 255.0f)];
+}
+
+void SpectrumView::addFrame(const SpectrumFrame& frame)
+{
+    const int bins = static_cast<int>(frame.magnitudes.size());
+    if (bins == 0)
+        return;
+
+    // Zmiana rozmiaru FFT – nowy spektrogram
+    if (spectrogram.width() != bins) {
+        spectrogram = QImage(bins, historyRows, QImage::Format_RGB32);
+        spectrogram.fill(palette[0]);
+        nextRow = 0;
+    }
+
+    QRgb *row = reinterpret_cast<QRgb*>(spectrogram.scanLine(nextRow));
+    for (int i = 0; i < bins; ++i)
+        row[i] = colorFor(frame.magnitudes[i]);
+    nextRow = (nextRow + 1) % historyRows;
+
+    lastFrame = frame;  // Tylko uchwyt do współdzielonych danych
+    update();           // Odrysowania są łączone przez Qt – najwyżej jedno na klatkę ekranu
+}
+
+void SpectrumView::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+
+    const int split = height() / 3;
+    const QRect spectrumRect(0, 0, width(), split);
+    const QRect spectrogramRect(0, split, width(), height() - split);
+
+    const int bins = static_cast<int>(lastFrame.magnitudes.size());
+    if (bins > 1) {
+        // Widmo w dB
+        QPainterPath path;
+        const double dx = spectrumRect.width() / static_cast<double>(bins - 1);
+        for (int i = 0; i < bins; ++i) {
+            const float db = 20.0f * std::log10(lastFrame.magnitudes[i] + 1e-6f);
+            const double t = std::clamp((db - minDb) / (maxDb - minDb), 0.0f, 1.0f);
+            const QPointF point(i * dx, spectrumRect.bottom() - t * spectrumRect.height());
+            if (i == 0)
+                path.moveTo(point);
+            else
+                path.lineTo(point);
+        }
+        painter.setPen(QColor(0, 220, 120));
+        painter.drawPath(path);
+
+        painter.setPen(Qt::white);
+        const double nyquist = lastFrame.binHz * (bins - 1);
+        painter.drawText(spectrumRect.adjusted(4, 4, -4, -4), Qt::AlignTop | Qt::AlignRight,
+                         QString("0 – %1 Hz, %2 Hz/bin").arg(nyquist, 0, 'f', 0).arg(lastFrame.binHz, 0, 'f', 2));
+    }
+
+    if (!spectrogram.isNull()) {
+        // Spektrogram z bufora cyklicznego: najstarsze wiersze (od nextRow) na górze
+        const int rows = spectrogram.height();
+        const int olderRows = rows - nextRow;
+        const double scaleY = spectrogramRect.height() / static_cast<double>(rows);
+        const int olderHeight = static_cast<int>(olderRows * scaleY);
+        painter.drawImage(QRect(0, spectrogramRect.top(), width(), olderHeight),
+                          spectrogram, QRect(0, nextRow, spectrogram.width(), olderRows));
+        if (nextRow > 0)
+            painter.drawImage(QRect(0, spectrogramRect.top() + olderHeight, width(), spectrogramRect.height() - olderHeight),
+                              spectrogram, QRect(0, 0, spectrogram.width(), nextRow));
+    }
+}
+
+SpectrumWindow::SpectrumWindow(QWidget *parent)
+    : QWidget(parent)
+{
+    setWindowTitle("Vibration spectrum");
+    resize(900, 600);
+
+    sizeCombo = new QComboBox(this);
+    sizeCombo->addItem("1024", 1024);
+    sizeCombo->addItem("4096", 4096);
+    channelCombo = new QComboBox(this);
+    channelCombo->addItem("X", static_cast<int>(SpectrumAnalyzer::Channel::X));
+    channelCombo->addItem("Y", static_cast<int>(SpectrumAnalyzer::Channel::Y));
+    channelCombo->addItem("Z", static_cast<int>(SpectrumAnalyzer::Channel::Z));
+    channelCombo->addItem("|a|", static_cast<int>(SpectrumAnalyzer::Channel::Magnitude));
+    channelCombo->setCurrentIndex(2);
+
+    QHBoxLayout *controls = new QHBoxLayout();
+    controls->addWidget(new QLabel("FFT size:", this));
+    controls->addWidget(sizeCombo);
+    controls->addWidget(new QLabel("Axis:", this));
+    controls->addWidget(channelCombo);
+    controls->addStretch();
+
+    view = new SpectrumView(this);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(controls);
+    layout->addWidget(view, 1);
+
+    // FFT liczona poza wątkiem GUI – nie opóźnia wykresów czasowych
+    analyzerThread = new QThread(this);
+    analyzerThread->setObjectName("SpectrumAnalyzer");
+    spectrumAnalyzer = new SpectrumAnalyzer();
+    spectrumAnalyzer->moveToThread(analyzerThread);
+    connect(analyzerThread, &QThread::finished, spectrumAnalyzer, &QObject::deleteLater);
+    connect(spectrumAnalyzer, &SpectrumAnalyzer::frameReady, view, &SpectrumView::addFrame);
+    analyzerThread->start();
+
+    connect(sizeCombo, &QComboBox::currentIndexChanged, this, &SpectrumWindow::reconfigure);
+    connect(channelCombo, &QComboBox::currentIndexChanged, this, &SpectrumWindow::reconfigure);
+    reconfigure();
+}
+
+SpectrumWindow::~SpectrumWindow()
+{
+    analyzerThread->quit();
+    analyzerThread->wait();
+}
+
+SpectrumAnalyzer* SpectrumWindow::analyzer() const
+{
+    return spectrumAnalyzer;
+}
+
+void SpectrumWindow::reconfigure()
+{
+    spectrumAnalyzer->configure(sizeCombo->currentData().toInt(),
+                                static_cast<SpectrumAnalyzer::Channel>(channelCombo->currentData().toInt()));
+}
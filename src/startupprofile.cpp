@@ -0,0 +1,111 @@
+#include "startupprofile.hpp"
+#include "accsample.hpp"
+#include <QEvent>
+#include <QFile>
+#include <QStringList>
+#include <QWidget>
+#include <utility>
+#include <vector>
+#ifdef Q_OS_LINUX
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace StartupProfile {
+
+namespace {
+
+// Najwcześniejsza chwila dostępna bez pomocy systemu – przed main()
+const std::int64_t staticInit = accTimestampNow();
+
+std::vector<std::pair<const char*, std::int64_t>> phases;
+
+#ifdef Q_OS_LINUX
+// Pole 22 /proc/self/stat: start procesu w taktach zegara od uruchomienia systemu
+std::int64_t linuxProcessStart()
+{
+    QFile file("/proc/self/stat");
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+    const QByteArray line = file.readAll();
+    // Nazwa programu (pole 2) może zawierać spacje – pola liczone od ostatniego ')'
+    const qsizetype close = line.lastIndexOf(')');
+    if (close < 0)
+        return 0;
+    const QList<QByteArray> fields = line.mid(close + 2).split(' ');
+    constexpr int StartTimeIndex = 22 - 3;
+    if (fields.size() <= StartTimeIndex)
+        return 0;
+    bool ok = false;
+    const qulonglong ticks = fields[StartTimeIndex].toULongLong(&ok);
+    const long hz = sysconf(_SC_CLK_TCK);
+    timespec boot;
+    if (!ok || hz <= 0 || clock_gettime(CLOCK_BOOTTIME, &boot) != 0)
+        return 0;
+    const std::int64_t now = accTimestampNow();
+    const std::int64_t sinceBoot = static_cast<std::int64_t>(boot.tv_sec) * 1'000'000'000 + boot.tv_nsec;
+    const std::int64_t startedAt = static_cast<std::int64_t>(ticks) * 1'000'000'000 / hz;
+    return now - (sinceBoot - startedAt);
+}
+#endif
+
+// Filtr zdarzeń usuwany po pierwszym QEvent::Paint
+class FirstPaintWatcher : public QObject
+{
+public:
+    FirstPaintWatcher(QWidget* widget, std::function<void(std::int64_t)> callback)
+        : QObject(widget), m_callback(std::move(callback))
+    {
+        widget->installEventFilter(this);
+    }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            watched->removeEventFilter(this);
+            m_callback(accTimestampNow());
+            deleteLater();
+        }
+        return false;
+    }
+
+private:
+    std::function<void(std::int64_t)> m_callback;
+};
+
+} // namespace
+
+std::int64_t processStart()
+{
+#ifdef Q_OS_LINUX
+    static const std::int64_t start = [] {
+        const std::int64_t started = linuxProcessStart();
+        return started > 0 && started <= staticInit ? started : staticInit;
+    }();
+    return start;
+#else
+    return staticInit;
+#endif
+}
+
+void mark(const char* phase)
+{
+    phases.emplace_back(phase, accTimestampNow());
+}
+
+QString summary()
+{
+    const std::int64_t start = processStart();
+    QStringList parts;
+    for (const auto& phase : phases)
+        parts.append(QString("%1 %2 ms").arg(phase.first).arg((phase.second - start) / 1e6, 0, 'f', 1));
+    return parts.join(", ");
+}
+
+void onFirstPaint(QWidget* widget, std::function<void(std::int64_t)> callback)
+{
+    new FirstPaintWatcher(widget, std::move(callback));
+}
+
+} // namespace StartupProfile
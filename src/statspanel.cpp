@@ -0,0 +1,85 @@
+#include "statspanel.hpp"
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QJsonDocument>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+StatsPanel::StatsPanel(QWidget *parent)
+    : QWidget(parent)
+{
+    setWindowTitle("Pipeline statistics");
+    resize(900, 320);
+
+    const QStringList columns = {"Events/s", "Samples/s", "p50 [µs]", "p99 [µs]", "Max [µs]",
+                                 "Dropped", "Coalesced", "Queue (max)"};
+    table = new QTableWidget(PipelineStats::StageCount, columns.size(), this);
+    table->setHorizontalHeaderLabels(columns);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int row = 0; row < PipelineStats::StageCount; ++row) {
+        table->setVerticalHeaderItem(row, new QTableWidgetItem(PipelineStats::stageName(static_cast<PipelineStats::Stage>(row))));
+        for (int column = 0; column < columns.size(); ++column) {
+            QTableWidgetItem *item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            table->setItem(row, column, item);
+        }
+    }
+
+    QPushButton *dumpButton = new QPushButton("Dump JSON", this);
+    connect(dumpButton, &QPushButton::clicked, this, &StatsPanel::dumpJson);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(table);
+    layout->addWidget(dumpButton, 0, Qt::AlignRight);
+
+    previous = PipelineStats::snapshot();
+    refreshTimer = new QTimer(this);
+    connect(refreshTimer, &QTimer::timeout, this, &StatsPanel::refresh);
+    refreshTimer->start(500);
+}
+
+void StatsPanel::refresh()
+{
+    const PipelineStats::Snapshot current = PipelineStats::snapshot();
+    const double seconds = (current.timestamp - previous.timestamp) / 1e9;
+    if (seconds <= 0.0)
+        return;
+
+    for (int row = 0; row < PipelineStats::StageCount; ++row) {
+        const PipelineStats::StageSnapshot &stage = current.stages[row];
+        const PipelineStats::StageSnapshot &before = previous.stages[row];
+        // Opóźnienia z ostatniego odświeżenia, a nie od startu – skok opóźnienia widać od razu
+        const HistogramSnapshot latency = stage.latency.since(before.latency);
+        const QStringList values = {
+            QString::number((stage.events - before.events) / seconds, 'f', 0),
+            QString::number((stage.samples - before.samples) / seconds, 'f', 0),
+            QString::number(latency.percentile(0.50) / 1e3, 'f', 1),
+            QString::number(latency.percentile(0.99) / 1e3, 'f', 1),
+            QString::number(latency.max / 1e3, 'f', 1),
+            QString::number(stage.dropped),
+            QString::number(stage.coalesced),
+            QString("%1 (%2)").arg(stage.queueDepth).arg(stage.maxQueueDepth),
+        };
+        for (int column = 0; column < values.size(); ++column)
+            table->item(row, column)->setText(values[column]);
+    }
+    previous = current;
+}
+
+void StatsPanel::dumpJson()
+{
+    const QString path = QFileDialog::getSaveFileName(this, "Save statistics", "pipeline-stats.json", "JSON (*.json)");
+    if (path.isEmpty())
+        return;
+
+    const PipelineStats::Snapshot current = PipelineStats::snapshot();
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMessageBox::warning(this, "Statistics", file.errorString());
+        return;
+    }
+    file.write(QJsonDocument(PipelineStats::toJson(current, &previous)).toJson());
+}
@@ -0,0 +1,282 @@
+#include "telemetryshm.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TELEMETRYSHM_POSIX 1
+#endif
+
+namespace TelemetryShm {
+
+namespace {
+
+std::uint32_t slotBytesFor(std::uint32_t slotSamples)
+{
+    const std::size_t bytes = sizeof(SlotHeader) + slotSamples * sizeof(AccSample);
+    return static_cast<std::uint32_t>((bytes + 63) & ~std::size_t(63));
+}
+
+inline SlotHeader* slotIn(const RingHeader* header, std::uint64_t sequence)
+{
+    const std::uint64_t index = sequence % header->slotCount;
+    auto base = reinterpret_cast<std::uintptr_t>(header) + sizeof(RingHeader);
+    return reinterpret_cast<SlotHeader*>(base + index * header->slotBytes);
+}
+
+inline AccSample* samplesOf(const SlotHeader* slot)
+{
+    return reinterpret_cast<AccSample*>(reinterpret_cast<std::uintptr_t>(slot) + sizeof(SlotHeader));
+}
+
+#ifdef TELEMETRYSHM_POSIX
+std::string systemError(const char* what)
+{
+    return std::string(what) + ": " + std::strerror(errno);
+}
+#endif
+
+} // namespace
+
+Writer::~Writer()
+{
+    close();
+}
+
+bool Writer::open(const std::string& name, std::uint32_t slotCount, std::uint32_t slotSamples)
+{
+    close();
+#ifdef TELEMETRYSHM_POSIX
+    if (slotCount == 0 || slotSamples == 0) {
+        m_error = "empty ring";
+        return false;
+    }
+    // Poprzedni segment (np. po awarii aplikacji) jest zastępowany – czytelnicy otwierają nowy
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        m_error = systemError("shm_open");
+        return false;
+    }
+    const std::uint32_t slotBytes = slotBytesFor(slotSamples);
+    const std::size_t size = sizeof(RingHeader) + static_cast<std::size_t>(slotCount) * slotBytes;
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        m_error = systemError("mmap");
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+    ::close(fd);
+
+    // Świeży segment jest wyzerowany, więc wersje gniazd (0) oznaczają "brak danych"
+    RingHeader* header = new (memory) RingHeader();
+    header->version = Version;
+    header->slotCount = slotCount;
+    header->slotSamples = slotSamples;
+    header->slotBytes = slotBytes;
+    header->sampleSize = sizeof(AccSample);
+    header->closed.store(0, std::memory_order_relaxed);
+    header->published.store(0, std::memory_order_relaxed);
+    for (std::uint32_t i = 0; i < slotCount; ++i)
+        new (slotIn(header, i)) SlotHeader{};
+    // Znacznik na końcu – czytelnik nie przyjmie segmentu w trakcie inicjalizacji
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, Magic, sizeof(Magic));
+
+    m_header = header;
+    m_size = size;
+    m_sequence = 0;
+    m_name = name;
+    return true;
+#else
+    (void)name;
+    (void)slotCount;
+    (void)slotSamples;
+    m_error = "shared memory requires a POSIX system";
+    return false;
+#endif
+}
+
+void Writer::close()
+{
+#ifdef TELEMETRYSHM_POSIX
+    if (!m_header)
+        return;
+    m_header->closed.store(1, std::memory_order_release);
+    munmap(m_header, m_size);
+    shm_unlink(m_name.c_str());
+    m_header = nullptr;
+#endif
+}
+
+// Seqlock: wersja nieparzysta przed zapisem danych, parzysta po nim (release)
+void Writer::publish(std::uint32_t streamId, const AccSample* samples, std::size_t count)
+{
+    if (!m_header)
+        return;
+    const std::size_t slotSamples = m_header->slotSamples;
+    for (std::size_t done = 0; done < count; done += slotSamples) {
+        const std::size_t n = std::min(slotSamples, count - done);
+        SlotHeader* slot = slotIn(m_header, m_sequence);
+        slot->version.store(2 * m_sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->streamId = streamId;
+        slot->count = static_cast<std::uint32_t>(n);
+        std::memcpy(samplesOf(slot), samples + done, n * sizeof(AccSample));
+        slot->version.store(2 * m_sequence + 2, std::memory_order_release);
+        ++m_sequence;
+        m_header->published.store(m_sequence, std::memory_order_release);
+    }
+}
+
+Reader::~Reader()
+{
+    close();
+}
+
+bool Reader::open(const std::string& name)
+{
+    close();
+#ifdef TELEMETRYSHM_POSIX
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        m_error = systemError("shm_open");
+        return false;
+    }
+    struct stat info;
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(RingHeader))
+        memory = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        m_error = "not a telemetry ring";
+        return false;
+    }
+
+    const auto* header = static_cast<const RingHeader*>(memory);
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    const bool valid = std::memcmp(header->magic, Magic, sizeof(Magic)) == 0 && header->version == Version
+                       && header->sampleSize == sizeof(AccSample) && header->slotCount > 0
+                       && header->slotBytes >= slotBytesFor(header->slotSamples)
+                       && sizeof(RingHeader) + static_cast<std::size_t>(header->slotCount) * header->slotBytes <= size;
+    if (!valid) {
+        munmap(memory, size);
+        m_error = "not a telemetry ring or incompatible version";
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Segment zamknięty, ale jeszcze nie usunięty – nowych danych w nim nie będzie
+    if (header->closed.load(std::memory_order_acquire)) {
+        munmap(memory, size);
+        m_error = "ring closed by the writer";
+        return false;
+    }
+
+    m_header = header;
+    m_size = size;
+    m_next = header->published.load(std::memory_order_acquire);
+    m_lost = 0;
+    m_overruns = 0;
+    return true;
+#else
+    (void)name;
+    m_error = "shared memory requires a POSIX system";
+    return false;
+#endif
+}
+
+void Reader::close()
+{
+#ifdef TELEMETRYSHM_POSIX
+    if (!m_header)
+        return;
+    munmap(const_cast<RingHeader*>(m_header), m_size);
+    m_header = nullptr;
+#endif
+}
+
+std::uint32_t Reader::slotSamples() const
+{
+    return m_header ? m_header->slotSamples : 0;
+}
+
+const SlotHeader* Reader::slotAt(std::uint64_t sequence) const
+{
+    return slotIn(m_header, sequence);
+}
+
+// Po nadpisaniu – skok do połowy pierścienia za pisarzem, żeby od razu nie trafić na kolejne nadpisanie
+void Reader::skipAhead()
+{
+    const std::uint64_t published = m_header->published.load(std::memory_order_acquire);
+    const std::uint64_t margin = std::max<std::uint64_t>(1, m_header->slotCount / 2);
+    const std::uint64_t resume = published > margin ? published - margin : 0;
+    if (resume > m_next) {
+        m_lost += resume - m_next;
+        m_next = resume;
+    } else {
+        ++m_lost;
+        ++m_next;
+    }
+    ++m_overruns;
+}
+
+Reader::Status Reader::view(View& view)
+{
+    if (!m_header)
+        return Status::Empty;
+    const SlotHeader* slot = slotAt(m_next);
+    const std::uint64_t ready = 2 * m_next + 2;
+    const std::uint64_t version = slot->version.load(std::memory_order_acquire);
+    if (version < ready) {
+        // Znacznik zamknięcia jest ustawiany po ostatnim bloku – sprawdzenie wersji jeszcze raz
+        // rozstrzyga, czy ten blok zdążył się pojawić
+        if (!m_header->closed.load(std::memory_order_acquire))
+            return Status::Empty;
+        return slot->version.load(std::memory_order_acquire) < ready ? Status::Closed : Status::Empty;
+    }
+    if (version > ready) {
+        skipAhead();
+        return Status::Overrun;
+    }
+    view.sequence = m_next;
+    view.streamId = slot->streamId;
+    view.count = std::min<std::size_t>(slot->count, m_header->slotSamples);
+    view.samples = samplesOf(slot);
+    view.version = version;
+    return Status::Ok;
+}
+
+bool Reader::release(const View& view)
+{
+    if (!m_header || view.sequence != m_next)
+        return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slotAt(view.sequence)->version.load(std::memory_order_relaxed) != view.version) {
+        skipAhead();
+        return false;
+    }
+    ++m_next;
+    return true;
+}
+
+Reader::Status Reader::next(Block& block)
+{
+    View current;
+    const Status status = view(current);
+    if (status != Status::Ok)
+        return status;
+    block.sequence = current.sequence;
+    block.streamId = current.streamId;
+    block.samples.assign(current.samples, current.samples + current.count);
+    return release(current) ? Status::Ok : Status::Overrun;
+}
+
+} // namespace TelemetryShm
@@ -0,0 +1,381 @@
+#include "telemetrystore.hpp"
+#include "pipelinestats.hpp"
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QPointer>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TelemetryStore::TelemetryStore(std::size_t rawBudgetBytes, std::size_t overviewBudgetBytes, QObject *parent)
+    : QObject(parent)
+    , maxChunks(std::max<std::size_t>(rawBudgetBytes / sizeof(Chunk), 2))
+    , overviewBudget(overviewBudgetBytes)
+    , epoch(accTimestampNow())
+{
+}
+
+TelemetryStore::~TelemetryStore() = default;
+
+// Właścicielem jest obiekt aplikacji: magazyn jest usuwany razem z QApplication, a nie po niej,
+// jak obiekt statyczny funkcji (QObject po zniszczeniu aplikacji)
+TelemetryStore* TelemetryStore::instance()
+{
+    static QPointer<TelemetryStore> store;
+    if (!store) {
+        Q_ASSERT(QCoreApplication::instance());
+        store = new TelemetryStore(DefaultRawBudget, DefaultOverviewBudget, QCoreApplication::instance());
+    }
+    return store;
+}
+
+void TelemetryStore::addSeries(int id, const QString& name)
+{
+    {
+        std::lock_guard<std::mutex> lock(seriesMutex);
+        if (series.count(id))
+            return;
+        auto created = std::make_shared<Series>();
+        created->name = name;
+        for (auto& pyramid : created->overview)
+            pyramid = std::make_unique<MinMaxPyramid>(overviewBudget / 3);
+        series.emplace(id, std::move(created));
+    }
+    emit seriesAdded(id, name);
+}
+
+void TelemetryStore::removeSeries(int id)
+{
+    {
+        // Zadanie puli, które właśnie dopisuje, trzyma własny wskaźnik – seria zniknie po nim
+        std::lock_guard<std::mutex> lock(seriesMutex);
+        if (series.erase(id) == 0)
+            return;
+    }
+    emit seriesRemoved(id);
+}
+
+void TelemetryStore::clearSeries(int id)
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(found->mutex);
+        clearLocked(*found);
+    }
+    emit seriesCleared(id);
+}
+
+void TelemetryStore::clearLocked(Series& target)
+{
+    target.freeChunks.insert(target.freeChunks.end(), target.chunks.begin(), target.chunks.end());
+    target.chunks.clear();
+    for (auto& pyramid : target.overview)
+        pyramid->clear();
+    target.count = 0;
+    target.interval.reset();
+    target.gaps.clear();
+}
+
+bool TelemetryStore::contains(int id) const
+{
+    std::lock_guard<std::mutex> lock(seriesMutex);
+    return series.count(id) != 0;
+}
+
+QList<int> TelemetryStore::seriesIds() const
+{
+    QList<int> ids;
+    std::lock_guard<std::mutex> lock(seriesMutex);
+    for (const auto& entry : series)
+        ids.append(entry.first);
+    return ids;
+}
+
+QString TelemetryStore::seriesName(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    return found ? found->name : QString();
+}
+
+std::shared_ptr<TelemetryStore::Series> TelemetryStore::find(int id) const
+{
+    std::lock_guard<std::mutex> lock(seriesMutex);
+    const auto it = series.find(id);
+    return it != series.end() ? it->second : nullptr;
+}
+
+TelemetryStore::Chunk* TelemetryStore::allocateChunk(Series& target)
+{
+    if (target.freeChunks.empty()) {
+        target.arena.push_back(std::make_unique<Chunk>());
+        return target.arena.back().get();
+    }
+    Chunk* chunk = target.freeChunks.back();
+    target.freeChunks.pop_back();
+    chunk->count = 0;
+    return chunk;
+}
+
+qint64 TelemetryStore::newestTimestamp(const Series& target)
+{
+    const Chunk* last = target.chunks.back();
+    return last->t[last->count - 1];
+}
+
+qint64 TelemetryStore::sampleCount(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    return found->count;
+}
+
+qint64 TelemetryStore::firstTimestamp(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    return found->chunks.empty() ? 0 : found->chunks.front()->t[0];
+}
+
+qint64 TelemetryStore::lastTimestamp(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    return found->chunks.empty() ? 0 : newestTimestamp(*found);
+}
+
+qint64 TelemetryStore::rejectedSamples(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    return found->rejected;
+}
+
+qint64 TelemetryStore::nominalInterval(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    return found->interval.interval();
+}
+
+qint64 TelemetryStore::gapCount(int id) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    return found->gapCount;
+}
+
+std::size_t TelemetryStore::gaps(int id, qint64 t0, qint64 t1, std::vector<Gap>& out) const
+{
+    out.clear();
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    // Przerwy są rozłączne i posortowane, więc końce też rosną
+    auto it = std::lower_bound(found->gaps.cbegin(), found->gaps.cend(), t0,
+                               [](const Gap& gap, qint64 ts) { return gap.end < ts; });
+    for (; it != found->gaps.cend() && it->start <= t1; ++it)
+        out.push_back(*it);
+    return out.size();
+}
+
+double TelemetryStore::toSeconds(qint64 timestamp) const
+{
+    return (timestamp - epoch) / 1e9;
+}
+
+qint64 TelemetryStore::fromSeconds(double seconds) const
+{
+    return epoch + static_cast<qint64>(std::llround(seconds * 1e9));
+}
+
+void TelemetryStore::append(int id, const AccSampleBlock& block)
+{
+    const std::shared_ptr<Series> found = block.isEmpty() ? nullptr : find(id);
+    if (!found)
+        return; // Seria usunięta, a jej ostatni blok był jeszcze w drodze
+    PipelineStats::ScopedTimer stats(PipelineStats::Stage::ChartAdd, block.size());
+
+    bool cleared = false;
+    qint64 last;
+    {
+        std::lock_guard<std::mutex> lock(found->mutex);
+        Series& target = *found;
+        last = target.chunks.empty() ? std::numeric_limits<qint64>::min() : newestTimestamp(target);
+        Chunk* chunk = target.chunks.empty() ? nullptr : target.chunks.back();
+        for (const AccSample& sample : block) {
+            // Kolumny są posortowane po czasie – tego wymaga wyszukiwanie binarne w zapytaniach.
+            // Powtórzony znacznik jest odrzucany, cofnięcie czasu (np. przewinięcie nagrania) zaczyna serię od nowa.
+            if (sample.timestamp == last) {
+                ++target.rejected;
+                continue;
+            }
+            if (sample.timestamp < last) {
+                clearLocked(target);
+                chunk = nullptr;
+                cleared = true;
+            }
+            last = sample.timestamp;
+
+            // Przerwy są zachowywane dłużej niż surowe próbki – przegląd historii też je pokazuje
+            const IntervalTracker::Step step = target.interval.observe(sample.timestamp);
+            if (step.gapNs > 0) {
+                target.gaps.push_back({sample.timestamp - step.gapNs, sample.timestamp});
+                ++target.gapCount;
+                if (target.gaps.size() > MaxGaps)
+                    target.gaps.pop_front();
+            }
+
+            if (!chunk || chunk->count == ChunkSamples) {
+                // Po przekroczeniu budżetu najstarsza porcja serii jest używana ponownie
+                if (target.chunks.size() >= maxChunks) {
+                    target.count -= static_cast<qint64>(target.chunks.front()->count);
+                    target.freeChunks.push_back(target.chunks.front());
+                    target.chunks.pop_front();
+                }
+                chunk = allocateChunk(target);
+                target.chunks.push_back(chunk);
+            }
+            const std::size_t i = chunk->count++;
+            chunk->t[i] = sample.timestamp;
+            chunk->x[i] = sample.x;
+            chunk->y[i] = sample.y;
+            chunk->z[i] = sample.z;
+            ++target.count;
+
+            const double time = toSeconds(sample.timestamp);
+            target.overview[0]->append(time, sample.x);
+            target.overview[1]->append(time, sample.y);
+            target.overview[2]->append(time, sample.z);
+        }
+    }
+    if (cleared)
+        emit seriesCleared(id);
+    notifyAppended(id, last);
+}
+
+void TelemetryStore::resetInterval(int id)
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    found->interval.reset();
+}
+
+// W wątku magazynu sygnał idzie od razu; z wątków puli dopisania są zbierane, a do kolejki
+// zdarzeń trafia najwyżej jedno zdarzenie naraz – niezależnie od liczby strumieni
+void TelemetryStore::notifyAppended(int id, qint64 lastTimestamp)
+{
+    if (QThread::currentThread() == thread()) {
+        emit appended(id, lastTimestamp);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(appendedMutex);
+        const auto it = std::find_if(appendedPending.begin(), appendedPending.end(),
+                                     [id](const std::pair<int, qint64>& entry) { return entry.first == id; });
+        if (it != appendedPending.end())
+            it->second = lastTimestamp;
+        else
+            appendedPending.emplace_back(id, lastTimestamp);
+        if (appendedPosted)
+            return;
+        appendedPosted = true;
+    }
+    QMetaObject::invokeMethod(this, [this]() { flushAppended(); }, Qt::QueuedConnection);
+}
+
+void TelemetryStore::flushAppended()
+{
+    std::vector<std::pair<int, qint64>> flushed;
+    {
+        std::lock_guard<std::mutex> lock(appendedMutex);
+        flushed.swap(appendedPending);
+        appendedPosted = false;
+    }
+    for (const std::pair<int, qint64>& entry : flushed)
+        emit appended(entry.first, entry.second);
+}
+
+void TelemetryStore::overview(int id, int axis, double t0, double t1, std::size_t maxBuckets,
+                              std::vector<MinMaxPyramid::Bucket>& out) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found || axis < 0 || axis > 2) {
+        out.clear();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(found->mutex);
+    found->overview[axis]->query(t0, t1, maxBuckets, out);
+}
+
+bool TelemetryStore::overviewRange(int id, double& oldest, double& newest) const
+{
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return false;
+    std::lock_guard<std::mutex> lock(found->mutex);
+    if (found->overview[0]->empty())
+        return false;
+    oldest = found->overview[0]->oldestTime();
+    newest = found->overview[0]->newestTime();
+    return true;
+}
+
+std::size_t TelemetryStore::samples(int id, qint64 t0, qint64 t1, std::vector<AccSample>& out,
+                                    std::size_t maxSamples) const
+{
+    out.clear();
+    const std::shared_ptr<Series> found = find(id);
+    if (!found)
+        return 0;
+    std::lock_guard<std::mutex> lock(found->mutex);
+
+    // Porcja: pierwsza, której ostatnia próbka nie jest wcześniejsza niż t0
+    const auto chunkIt = std::lower_bound(found->chunks.cbegin(), found->chunks.cend(), t0,
+                                          [](const Chunk* chunk, qint64 ts) { return chunk->t[chunk->count - 1] < ts; });
+    for (auto it = chunkIt; it != found->chunks.cend() && out.size() < maxSamples; ++it) {
+        const Chunk* chunk = *it;
+        std::size_t i = static_cast<std::size_t>(std::lower_bound(chunk->t, chunk->t + chunk->count, t0) - chunk->t);
+        for (; i < chunk->count && out.size() < maxSamples; ++i) {
+            if (chunk->t[i] > t1)
+                return out.size();
+            out.push_back({chunk->t[i], chunk->x[i], chunk->y[i], chunk->z[i]});
+        }
+    }
+    return out.size();
+}
+
+std::size_t TelemetryStore::memoryBytes() const
+{
+    std::vector<std::shared_ptr<Series>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(seriesMutex);
+        for (const auto& entry : series)
+            snapshot.push_back(entry.second);
+    }
+    std::size_t total = 0;
+    for (const std::shared_ptr<Series>& entry : snapshot) {
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        total += entry->arena.size() * sizeof(Chunk);
+        for (const auto& pyramid : entry->overview)
+            total += pyramid->memoryBytes();
+    }
+    return total;
+}
@@ -0,0 +1,98 @@
+#include "workstealingpool.hpp"
+#include <algorithm>
+
+namespace {
+// Pula i indeks wątku roboczego, w którym wykonuje się bieżący kod (nullptr poza pulą)
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local std::size_t currentIndex = 0;
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+    if (threads == 0) {
+        const unsigned cores = std::thread::hardware_concurrency();
+        threads = cores > 1 ? cores - 1 : 1;
+    }
+    for (std::size_t i = 0; i < threads; ++i)
+        m_queues.push_back(std::make_unique<Queue>());
+    for (std::size_t i = 0; i < threads; ++i)
+        m_threads.emplace_back([this, i]() { workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+// Licznik rośnie przed wstawieniem zadania, więc wątek, który je pobierze, nigdy nie zejdzie poniżej zera,
+// a m_pending == 0 oznacza puste kolejki. Pobudka (i blokada m_sleepMutex) tylko, gdy jakiś wątek śpi:
+// operacje seq_cst na m_pending i m_sleepers gwarantują, że albo zgłaszający zobaczy śpiącego,
+// albo zasypiający zobaczy nowe zadanie.
+void WorkStealingPool::submit(std::function<void()> task)
+{
+    const std::size_t index = currentPool == this
+        ? currentIndex
+        : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+    m_pending.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    if (m_sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wake.notify_one();
+    }
+}
+
+bool WorkStealingPool::tryPop(std::size_t index, std::function<void()>& task)
+{
+    {
+        Queue& own = *m_queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    // Kradzież: przegląd pozostałych kolejek, zaczynając od sąsiada
+    for (std::size_t offset = 1; offset < m_queues.size(); ++offset) {
+        Queue& victim = *m_queues[(index + offset) % m_queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    std::function<void()> task;
+    for (;;) {
+        if (tryPop(index, task)) {
+            m_pending.fetch_sub(1);
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wake.wait(lock, [this]() { return m_stop || m_pending.load() > 0; });
+        m_sleepers.fetch_sub(1);
+        if (m_stop && m_pending.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,125 @@
+// Dekoder eksportu sesji (*.accz) do CSV: stream,timestamp_ns,x,y,z.
+// Bloki są niezależne, więc uszkodzony lub ucięty fragment pliku jest pomijany,
+// a dekodowanie wznawia się od następnego znacznika bloku.
+//
+// Użycie: accz2csv plik.accz [wynik.csv] [--stream N]
+
+#include "sessioncodec.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t ReadSize = 1 << 20;
+constexpr std::size_t MaxPayloadBytes = 64u << 20; ///< Większy blok uznajemy za uszkodzony nagłówek.
+
+// Bufor wczytywanego pliku: dane od pos do końca wektora są jeszcze nieprzetworzone
+struct Input
+{
+    std::FILE* file = nullptr;
+    std::vector<std::uint8_t> data;
+    std::size_t pos = 0;
+    bool eof = false;
+
+    // Co najmniej count bajtów od pos; false na końcu pliku
+    bool require(std::size_t count)
+    {
+        while (data.size() - pos < count && !eof) {
+            data.erase(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(pos));
+            pos = 0;
+            const std::size_t old = data.size();
+            data.resize(old + std::max(ReadSize, count));
+            const std::size_t got = std::fread(data.data() + old, 1, data.size() - old, file);
+            data.resize(old + got);
+            eof = got == 0;
+        }
+        return data.size() - pos >= count;
+    }
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+    long streamFilter = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--stream") == 0 && i + 1 < argc)
+            streamFilter = std::strtol(argv[++i], nullptr, 10);
+        else if (!inputPath)
+            inputPath = argv[i];
+        else if (!outputPath)
+            outputPath = argv[i];
+    }
+    if (!inputPath) {
+        std::fprintf(stderr, "usage: %s input.accz [output.csv] [--stream N]\n", argv[0]);
+        return 2;
+    }
+
+    Input input;
+    input.file = std::fopen(inputPath, "rb");
+    if (!input.file) {
+        std::perror(inputPath);
+        return 1;
+    }
+    std::FILE* output = outputPath ? std::fopen(outputPath, "w") : stdout;
+    if (!output) {
+        std::perror(outputPath);
+        return 1;
+    }
+
+    SessionExportFormat::FileHeader fileHeader;
+    if (!input.require(sizeof(fileHeader))
+        || std::memcmp(input.data.data(), SessionExportFormat::FileMagic, sizeof(fileHeader.magic)) != 0) {
+        std::fprintf(stderr, "%s: not a session export file\n", inputPath);
+        return 1;
+    }
+    std::memcpy(&fileHeader, input.data.data(), sizeof(fileHeader));
+    if (fileHeader.version != SessionExportFormat::Version) {
+        std::fprintf(stderr, "%s: unsupported version %u\n", inputPath, fileHeader.version);
+        return 1;
+    }
+    input.pos = sizeof(fileHeader);
+
+    std::fprintf(output, "stream,timestamp_ns,x,y,z\n");
+    SessionExportFormat::BlockHeader header;
+    std::vector<AccSample> samples;
+    std::uint64_t blocks = 0;
+    std::uint64_t decoded = 0;
+    std::uint64_t skippedBytes = 0;
+    while (input.require(sizeof(header))) {
+        std::memcpy(&header, input.data.data() + input.pos, sizeof(header));
+        std::size_t consumed = 0;
+        const bool plausible = header.magic == SessionExportFormat::BlockMagic && header.payloadBytes <= MaxPayloadBytes;
+        if (!plausible || !input.require(sizeof(header) + header.payloadBytes)
+            || !SessionCodec::decodeBlock(input.data.data() + input.pos, input.data.size() - input.pos,
+                                          header, samples, consumed)) {
+            // Resynchronizacja: szukanie następnego nagłówka od kolejnego bajtu
+            ++input.pos;
+            ++skippedBytes;
+            continue;
+        }
+        input.pos += consumed;
+        ++blocks;
+        if (streamFilter >= 0 && header.streamId != static_cast<std::uint32_t>(streamFilter))
+            continue;
+        for (const AccSample& sample : samples) {
+            std::fprintf(output, "%u,%lld,%.17g,%.17g,%.17g\n", header.streamId,
+                         static_cast<long long>(sample.timestamp), sample.x, sample.y, sample.z);
+        }
+        decoded += samples.size();
+    }
+
+    std::fclose(input.file);
+    if (output != stdout)
+        std::fclose(output);
+    std::fprintf(stderr, "%llu blocks, %llu samples, %llu bytes skipped\n",
+                 static_cast<unsigned long long>(blocks), static_cast<unsigned long long>(decoded),
+                 static_cast<unsigned long long>(skippedBytes));
+    return 0;
+}
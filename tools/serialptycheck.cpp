@@ -0,0 +1,249 @@
+// Sprawdzenie SerialReader na pseudo-terminalu: narzędzie otwiera parę pty (openpty),
+// podłącza czytnik do strony podrzędnej i wpisuje do strony nadrzędnej ramki z encodeAccFrame().
+// Kolejne scenariusze sprawdzają próbki pobrane przez drain() i liczniki parsera:
+//  - poprawne ramki przechodzą bez strat i z rosnącymi znacznikami czasu,
+//  - przypadkowe bajty między ramkami są pomijane, a parser odzyskuje synchronizację,
+//  - ramka zapisana w dwóch porcjach czeka na resztę i dociera w całości,
+//  - ramka z uszkodzonym bajtem danych jest odrzucana przez CRC, a następne przechodzą.
+// Kod wyjścia 0 – wszystkie scenariusze zaliczone; rejestrowane też jako test CTest.
+//
+// Użycie: serialptycheck
+
+#include "accframe.hpp"
+#include "serialreader.hpp"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+#ifdef __APPLE__
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+namespace {
+
+constexpr int TimeoutMs = 2000;
+
+// Obsługa zdarzeń (sygnały czytnika przychodzą kolejką) do spełnienia warunku albo limitu czasu
+bool waitFor(const std::function<bool()>& condition, int timeoutMs = TimeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > timeoutMs)
+            return false;
+        QCoreApplication::processEvents();
+        QThread::msleep(2);
+    }
+    return true;
+}
+
+bool writeAll(int fd, const std::uint8_t* data, std::size_t size)
+{
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0)
+            return false;
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+// Wartości osi nie zawierają bajtów 0xA5 0x5A, więc w danych nie ma fałszywych znaczników
+AccFrame makeFrame(std::uint16_t sequence)
+{
+    return {sequence, 1000u * sequence, 0.25f * sequence, -1.0f, 0.5f + sequence};
+}
+
+void appendFrame(std::vector<std::uint8_t>& out, const AccFrame& frame)
+{
+    std::uint8_t bytes[AccFrameFormat::FrameSize];
+    encodeAccFrame(frame, bytes);
+    out.insert(out.end(), bytes, bytes + AccFrameFormat::FrameSize);
+}
+
+class Harness
+{
+public:
+    Harness(SerialReader& reader, int master)
+        : m_reader(reader)
+        , m_master(master)
+    {
+    }
+
+    // Oczekiwane ramki muszą dotrzeć w kolejności i bez zmian; liczniki parsera porównywane
+    // są jako przyrosty względem poprzedniego scenariusza
+    bool expect(const char* name, const std::vector<AccFrame>& frames, const AccFrameParser::Stats& delta)
+    {
+        const AccFrameParser::Stats before = m_stats;
+        std::vector<AccSample> samples;
+        const bool complete = waitFor([&]() {
+            drainInto(samples);
+            m_stats = m_reader.parserStats();
+            return samples.size() >= frames.size() && m_stats.frames >= before.frames + frames.size();
+        });
+        // Krótka przerwa wychwytuje próbki nadmiarowe, np. z ramki, która nie powinna przejść
+        QThread::msleep(20);
+        QCoreApplication::processEvents();
+        drainInto(samples);
+        m_stats = m_reader.parserStats();
+
+        bool ok = complete && samples.size() == frames.size();
+        for (std::size_t i = 0; ok && i < frames.size(); ++i) {
+            ok = samples[i].x == frames[i].x && samples[i].y == frames[i].y && samples[i].z == frames[i].z
+                && samples[i].timestamp > m_lastTimestamp;
+            m_lastTimestamp = samples[i].timestamp;
+        }
+        ok = ok && m_stats.frames - before.frames == delta.frames
+            && m_stats.crcErrors - before.crcErrors == delta.crcErrors
+            && m_stats.skippedBytes - before.skippedBytes == delta.skippedBytes
+            && m_stats.lostFrames - before.lostFrames == delta.lostFrames;
+
+        std::printf("%s %-14s samples %zu/%zu, frames +%llu, crc errors +%llu, skipped bytes +%llu, lost +%llu\n",
+                    ok ? "PASS" : "FAIL", name, samples.size(), frames.size(),
+                    static_cast<unsigned long long>(m_stats.frames - before.frames),
+                    static_cast<unsigned long long>(m_stats.crcErrors - before.crcErrors),
+                    static_cast<unsigned long long>(m_stats.skippedBytes - before.skippedBytes),
+                    static_cast<unsigned long long>(m_stats.lostFrames - before.lostFrames));
+        return ok;
+    }
+
+    bool write(const std::vector<std::uint8_t>& bytes) { return writeAll(m_master, bytes.data(), bytes.size()); }
+
+    std::size_t pendingSamples()
+    {
+        std::vector<AccSample> samples;
+        QCoreApplication::processEvents();
+        drainInto(samples);
+        return samples.size();
+    }
+
+private:
+    void drainInto(std::vector<AccSample>& samples)
+    {
+        AccSample chunk[256];
+        std::size_t count;
+        while ((count = m_reader.drain(chunk, 256)) > 0)
+            samples.insert(samples.end(), chunk, chunk + count);
+    }
+
+    SerialReader& m_reader;
+    int m_master;
+    AccFrameParser::Stats m_stats;
+    std::int64_t m_lastTimestamp = 0;
+};
+
+AccFrameParser::Stats statsDelta(std::uint64_t frames, std::uint64_t crcErrors, std::uint64_t skippedBytes,
+                                 std::uint64_t lostFrames)
+{
+    AccFrameParser::Stats stats;
+    stats.frames = frames;
+    stats.crcErrors = crcErrors;
+    stats.skippedBytes = skippedBytes;
+    stats.lostFrames = lostFrames;
+    return stats;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    // Strona podrzędna w trybie surowym – dyscyplina linii nie może przekształcać bajtów ramek
+    termios mode;
+    std::memset(&mode, 0, sizeof(mode));
+    cfmakeraw(&mode);
+    int master = -1;
+    int slave = -1;
+    if (openpty(&master, &slave, nullptr, &mode, nullptr) != 0) {
+        std::perror("openpty");
+        return 1;
+    }
+    const QString portName = QString::fromLocal8Bit(ptsname(master));
+
+    int failures = 0;
+    {
+        SerialReader reader;
+        QString error;
+        QObject::connect(&reader, &SerialReader::errorOccurred, [&error](const QString& message) { error = message; });
+        reader.start(portName);
+        if (!waitFor([&]() { return reader.isRunning() || !error.isEmpty(); }) || !reader.isRunning()) {
+            std::fprintf(stderr, "%s: %s\n", qPrintable(portName), error.isEmpty() ? "timeout" : qPrintable(error));
+            close(slave);
+            close(master);
+            return 1;
+        }
+
+        Harness harness(reader, master);
+        std::uint16_t sequence = 0;
+        std::vector<std::uint8_t> bytes;
+        std::vector<AccFrame> frames;
+
+        // Poprawne ramki
+        for (int i = 0; i < 16; ++i) {
+            frames.push_back(makeFrame(sequence++));
+            appendFrame(bytes, frames.back());
+        }
+        harness.write(bytes);
+        failures += !harness.expect("clean", frames, statsDelta(16, 0, 0, 0));
+
+        // Przypadkowe bajty między ramkami, w tym samotny pierwszy bajt znacznika synchronizacji
+        bytes.clear();
+        frames.clear();
+        frames.push_back(makeFrame(sequence++));
+        appendFrame(bytes, frames.back());
+        const std::uint8_t garbage[] = {0x00, AccFrameFormat::Sync0, 0x13};
+        bytes.insert(bytes.end(), garbage, garbage + sizeof(garbage));
+        for (int i = 0; i < 3; ++i) {
+            frames.push_back(makeFrame(sequence++));
+            appendFrame(bytes, frames.back());
+        }
+        harness.write(bytes);
+        failures += !harness.expect("resync", frames, statsDelta(4, 0, sizeof(garbage), 0));
+
+        // Ramka w dwóch porcjach: po pierwszej czytnik nie może wydać żadnej próbki
+        bytes.clear();
+        frames.clear();
+        frames.push_back(makeFrame(sequence++));
+        appendFrame(bytes, frames.back());
+        const std::size_t split = 9;
+        writeAll(master, bytes.data(), split);
+        QThread::msleep(50);
+        if (harness.pendingSamples() != 0) {
+            std::printf("FAIL split frame delivered before its tail\n");
+            ++failures;
+        }
+        writeAll(master, bytes.data() + split, bytes.size() - split);
+        failures += !harness.expect("split frame", frames, statsDelta(1, 0, 0, 0));
+
+        // Uszkodzony bajt danych: ramka odrzucona przez CRC (22 pominięte bajty), następne przechodzą,
+        // a luka w numeracji liczy się jako ramka utracona
+        bytes.clear();
+        frames.clear();
+        appendFrame(bytes, makeFrame(sequence++));
+        bytes[10] ^= 0x40;
+        for (int i = 0; i < 3; ++i) {
+            frames.push_back(makeFrame(sequence++));
+            appendFrame(bytes, frames.back());
+        }
+        harness.write(bytes);
+        failures += !harness.expect("bad crc", frames, statsDelta(3, 1, AccFrameFormat::FrameSize, 1));
+
+        reader.stop();
+        waitFor([&]() { return !reader.isRunning(); });
+    }
+
+    close(slave);
+    close(master);
+    std::printf("%s\n", failures == 0 ? "all scenarios passed" : "some scenarios failed");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+// Most pierścienia telemetrii (TelemetryShm) do gniazda datagramowego – dla odbiorców,
+// którzy nie mają dostępu do pamięci współdzielonej (inny kontener, skrypt bez mmap).
+// Każdy blok pierścienia to jeden datagram: TelemetryShm::DatagramHeader + próbki.
+// Most jest zwykłym czytelnikiem pierścienia, więc nie spowalnia aplikacji; gdy nie
+// nadąża, bloki są tracone i liczone tak jak w każdym innym kliencie. Po zamknięciu pierścienia
+// przez aplikację most czeka na nowy segment o tej samej nazwie i wznawia przesyłanie
+// (numeracja bloków w datagramach zaczyna się wtedy od nowa).
+//
+// Użycie: shmbridge [--name /qtdrone-telemetry] (--udp HOST:PORT | --unix ŚCIEŻKA) [--stream N]
+
+#include "telemetryshm.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void onSignal(int)
+{
+    stopRequested = 1;
+}
+
+bool parseUdp(const std::string& address, sockaddr_in& out)
+{
+    const std::size_t colon = address.rfind(':');
+    if (colon == std::string::npos)
+        return false;
+    std::memset(&out, 0, sizeof(out));
+    out.sin_family = AF_INET;
+    out.sin_port = htons(static_cast<std::uint16_t>(std::atoi(address.c_str() + colon + 1)));
+    return inet_pton(AF_INET, address.substr(0, colon).c_str(), &out.sin_addr) == 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    std::string name = TelemetryShm::DefaultName;
+    std::string udp;
+    std::string unixPath;
+    long streamFilter = -1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--name") == 0)
+            name = argv[i + 1];
+        else if (std::strcmp(argv[i], "--udp") == 0)
+            udp = argv[i + 1];
+        else if (std::strcmp(argv[i], "--unix") == 0)
+            unixPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--stream") == 0)
+            streamFilter = std::strtol(argv[i + 1], nullptr, 10);
+    }
+    if (udp.empty() == unixPath.empty()) {
+        std::fprintf(stderr, "usage: %s [--name SHM] (--udp HOST:PORT | --unix PATH) [--stream N]\n", argv[0]);
+        return 2;
+    }
+
+    // Adres docelowy: UDP albo gniazdo datagramowe Unix
+    sockaddr_storage target;
+    socklen_t targetSize = 0;
+    std::memset(&target, 0, sizeof(target));
+    int family = AF_INET;
+    if (!udp.empty()) {
+        if (!parseUdp(udp, reinterpret_cast<sockaddr_in&>(target))) {
+            std::fprintf(stderr, "invalid UDP address: %s\n", udp.c_str());
+            return 2;
+        }
+        targetSize = sizeof(sockaddr_in);
+    } else {
+        auto& address = reinterpret_cast<sockaddr_un&>(target);
+        if (unixPath.size() >= sizeof(address.sun_path)) {
+            std::fprintf(stderr, "socket path too long: %s\n", unixPath.c_str());
+            return 2;
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, unixPath.c_str(), unixPath.size() + 1);
+        targetSize = sizeof(sockaddr_un);
+        family = AF_UNIX;
+    }
+    const int socketFd = socket(family, SOCK_DGRAM, 0);
+    if (socketFd < 0) {
+        std::perror("socket");
+        return 1;
+    }
+
+    TelemetryShm::Reader reader;
+    if (!reader.open(name)) {
+        std::fprintf(stderr, "%s: %s\n", name.c_str(), reader.errorString().c_str());
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::vector<char> datagram(sizeof(TelemetryShm::DatagramHeader) + reader.slotSamples() * sizeof(AccSample));
+    TelemetryShm::Reader::View view;
+    std::uint64_t sent = 0;
+    std::uint64_t sendErrors = 0;
+    std::uint64_t lost = 0;
+    std::uint64_t overruns = 0;
+    while (!stopRequested) {
+        const TelemetryShm::Reader::Status status = reader.view(view);
+        if (status == TelemetryShm::Reader::Status::Empty) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        if (status == TelemetryShm::Reader::Status::Closed) {
+            // Aplikacja zamknęła pierścień – czekamy, aż utworzy nowy (np. po ponownym uruchomieniu)
+            std::fprintf(stderr, "%s: ring closed by the writer, waiting for a new one\n", name.c_str());
+            lost += reader.lostBlocks();
+            overruns += reader.overruns();
+            reader.close();
+            while (!stopRequested && !reader.open(name))
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            if (reader.isOpen())
+                datagram.resize(sizeof(TelemetryShm::DatagramHeader) + reader.slotSamples() * sizeof(AccSample));
+            continue;
+        }
+        if (status != TelemetryShm::Reader::Status::Ok)
+            continue;
+
+        // Kopia prosto z pierścienia do datagramu; ważna dopiero po release()
+        TelemetryShm::DatagramHeader header;
+        header.magic = TelemetryShm::DatagramMagic;
+        header.streamId = view.streamId;
+        header.sequence = view.sequence;
+        header.count = static_cast<std::uint32_t>(view.count);
+        header.reserved = 0;
+        std::memcpy(datagram.data(), &header, sizeof(header));
+        std::memcpy(datagram.data() + sizeof(header), view.samples, view.count * sizeof(AccSample));
+        if (!reader.release(view))
+            continue;
+        if (streamFilter >= 0 && view.streamId != static_cast<std::uint32_t>(streamFilter))
+            continue;
+
+        const std::size_t size = sizeof(header) + view.count * sizeof(AccSample);
+        if (sendto(socketFd, datagram.data(), size, 0, reinterpret_cast<const sockaddr*>(&target), targetSize) < 0)
+            ++sendErrors;
+        else
+            ++sent;
+    }
+
+    close(socketFd);
+    std::fprintf(stderr, "%llu datagrams sent, %llu send errors, %llu blocks lost in %llu overruns\n",
+                 static_cast<unsigned long long>(sent), static_cast<unsigned long long>(sendErrors),
+                 static_cast<unsigned long long>(lost + reader.lostBlocks()),
+                 static_cast<unsigned long long>(overruns + reader.overruns()));
+    return 0;
+}